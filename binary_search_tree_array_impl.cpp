@@ -1,102 +1,139 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
 
 // Structure representing a BinarySearchTree using a free-node pool.
+template <typename T, typename Index = int>
 struct BinarySearchTree {
-    int root{-1}; // Index of the root node.
+    Index root{NULL_INDEX<Index>}; // Index of the root node.
 
-    // Free-node pool holding node arrays and free list information.
+    // Free-node pool holding node arrays and their occupancy allocator.
     struct {
-        std::unique_ptr<float[]> key{nullptr};    // Node key values.
-        std::unique_ptr<int[]> left{nullptr};       // Left child indices.
-        std::unique_ptr<int[]> right{nullptr};      // Right child indices.
-        std::unique_ptr<int[]> next_free{nullptr};  // Free list linking.
-        std::unique_ptr<bool[]> allocated{nullptr}; // Allocation flags.
-        size_t size{0};                             // Total number of nodes.
-        int free_head{-1};                          // Head of the free list.
+        std::unique_ptr<T[]> key{nullptr};       // Node key values.
+        std::unique_ptr<Index[]> left{nullptr};  // Left child indices.
+        std::unique_ptr<Index[]> right{nullptr}; // Right child indices.
+        NodePool<Index> slots;                   // Occupancy bitmap allocator.
+        bool growable{true};                     // Grow the pool when it runs out of free nodes.
     } pool;
 };
 
 // Initialize the BinarySearchTree with N nodes.
-// All nodes are initially free and linked into the free list.
-void BinarySearchTree_init(BinarySearchTree &tree, const size_t &N) {
-    tree.root = -1;
-    tree.pool.size = N;
-    tree.pool.key = std::make_unique<float[]>(N);
-    tree.pool.left = std::make_unique<int[]>(N);
-    tree.pool.right = std::make_unique<int[]>(N);
-    tree.pool.next_free = std::make_unique<int[]>(N);
-    tree.pool.allocated = std::make_unique<bool[]>(N);
-    tree.pool.free_head = 0;  // Free list starts at index 0.
+// All nodes are initially free.
+template <typename T, typename Index>
+void BinarySearchTree_init(BinarySearchTree<T, Index> &tree, const size_t &N) {
+    tree.root = NULL_INDEX<Index>;
+    NodePool_init(tree.pool.slots, N);
+    tree.pool.key = make_payload_array<T>(N);
+    tree.pool.left = std::make_unique<Index[]>(N);
+    tree.pool.right = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i) {
-        tree.pool.key[i] = 0.0f;
-        tree.pool.left[i] = -1;
-        tree.pool.right[i] = -1;
-        tree.pool.allocated[i] = false;
-        tree.pool.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+        tree.pool.left[i] = NULL_INDEX<Index>;
+        tree.pool.right[i] = NULL_INDEX<Index>;
+    }
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool BinarySearchTree_growPool(BinarySearchTree<T, Index> &tree) {
+    const size_t old_size = tree.pool.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(tree.pool.slots, new_size))
+        return false;
+
+    auto key = make_payload_array<T>(new_size);
+    auto left = std::make_unique<Index[]>(new_size);
+    auto right = std::make_unique<Index[]>(new_size);
+
+    std::move(tree.pool.key.get(), tree.pool.key.get() + old_size, key.get());
+    std::copy_n(tree.pool.left.get(), old_size, left.get());
+    std::copy_n(tree.pool.right.get(), old_size, right.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        left[i] = NULL_INDEX<Index>;
+        right[i] = NULL_INDEX<Index>;
     }
+
+    tree.pool.key = std::move(key);
+    tree.pool.left = std::move(left);
+    tree.pool.right = std::move(right);
+    return true;
 }
 
-// Allocate a node from the free list.
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
 // Initializes the node with the provided key and returns its index via node_idx.
-void BinarySearchTree_allocateNode(BinarySearchTree &tree, const float &key, int &node_idx) {
-    node_idx = -1;
-    if (tree.pool.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void BinarySearchTree_allocateNode(BinarySearchTree<T, Index> &tree, const T &key, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(tree.pool.slots) &&
+        !(tree.pool.growable && BinarySearchTree_growPool(tree))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // "Pop" a node from the free list.
-    node_idx = tree.pool.free_head;
-    tree.pool.free_head = tree.pool.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(tree.pool.slots, node_idx);
 
     // Initialize the node.
     tree.pool.key[node_idx] = key;
-    tree.pool.left[node_idx] = -1;
-    tree.pool.right[node_idx] = -1;
-    tree.pool.allocated[node_idx] = true;
+    tree.pool.left[node_idx] = NULL_INDEX<Index>;
+    tree.pool.right[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by pushing it back onto the free list.
-void BinarySearchTree_deallocateNode(BinarySearchTree &tree, const size_t &idx) {
-    if (idx >= tree.pool.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+// Deallocate a node by returning it to the pool.
+template <typename T, typename Index>
+void BinarySearchTree_deallocateNode(BinarySearchTree<T, Index> &tree, const size_t &idx) {
+    if (idx >= tree.pool.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
-    if (!tree.pool.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(tree.pool.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     // Reset node's content.
-    tree.pool.key[idx] = 0.0f;
-    tree.pool.left[idx] = -1;
-    tree.pool.right[idx] = -1;
-    tree.pool.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        tree.pool.key[idx] = T{}; // Release resources held by the payload.
+    tree.pool.left[idx] = NULL_INDEX<Index>;
+    tree.pool.right[idx] = NULL_INDEX<Index>;
 
-    // Push node back into the free list.
-    tree.pool.next_free[idx] = tree.pool.free_head;
-    tree.pool.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(tree.pool.slots, idx);
 }
 
 // Insert a key into the BinarySearchTree.
-void BinarySearchTree_insert(BinarySearchTree &tree, const float &key) {
-    int new_node = -1;
+template <typename T, typename Index>
+void BinarySearchTree_insert(BinarySearchTree<T, Index> &tree, const T &key) {
+    Index new_node = NULL_INDEX<Index>;
     BinarySearchTree_allocateNode(tree, key, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
     // If the tree is empty, set the new node as the root.
-    if (tree.root == -1) {
+    if (tree.root == NULL_INDEX<Index>) {
         tree.root = new_node;
         return;
     }
 
     // Otherwise, find the correct spot for insertion.
-    int current = tree.root;
+    Index current = tree.root;
     while (true) {
         if (key < tree.pool.key[current]) {
             // Go left.
-            if (tree.pool.left[current] == -1) {
+            if (tree.pool.left[current] == NULL_INDEX<Index>) {
                 tree.pool.left[current] = new_node;
                 break;
             } else {
@@ -104,7 +141,7 @@ void BinarySearchTree_insert(BinarySearchTree &tree, const float &key) {
             }
         } else {
             // Go right.
-            if (tree.pool.right[current] == -1) {
+            if (tree.pool.right[current] == NULL_INDEX<Index>) {
                 tree.pool.right[current] = new_node;
                 break;
             } else {
@@ -115,10 +152,11 @@ void BinarySearchTree_insert(BinarySearchTree &tree, const float &key) {
 }
 
 // Search for a key in the BinarySearchTree.
-// Returns the node index via result if found; otherwise, result is set to -1.
-void BinarySearchTree_search(BinarySearchTree &tree, const float &key, int &result) {
-    int current = tree.root;
-    while (current != -1) {
+// Returns the node index via result if found; otherwise, result is set to NULL_INDEX.
+template <typename T, typename Index>
+void BinarySearchTree_search(BinarySearchTree<T, Index> &tree, const T &key, Index &result) {
+    Index current = tree.root;
+    while (current != NULL_INDEX<Index>) {
         if (tree.pool.key[current] == key) {
             result = current;
             return;
@@ -128,24 +166,26 @@ void BinarySearchTree_search(BinarySearchTree &tree, const float &key, int &resu
         else
             current = tree.pool.right[current];
     }
-    result = -1;
+    result = NULL_INDEX<Index>;
 }
 
 // Helper function: find the minimum node in the subtree rooted at node_idx.
-int BinarySearchTree_findMin(BinarySearchTree &tree, int node_idx) {
-    while (tree.pool.left[node_idx] != -1)
+template <typename T, typename Index>
+Index BinarySearchTree_findMin(BinarySearchTree<T, Index> &tree, Index node_idx) {
+    while (tree.pool.left[node_idx] != NULL_INDEX<Index>)
         node_idx = tree.pool.left[node_idx];
     return node_idx;
 }
 
 // Delete a node with the specified key from the BinarySearchTree.
-void BinarySearchTree_delete(BinarySearchTree &tree, const float &key) {
-    int parent = -1;
-    int current = tree.root;
+template <typename T, typename Index>
+void BinarySearchTree_delete(BinarySearchTree<T, Index> &tree, const T &key) {
+    Index parent = NULL_INDEX<Index>;
+    Index current = tree.root;
     bool isLeftChild = false;
     
     // Locate the node to delete and its parent.
-    while (current != -1 && tree.pool.key[current] != key) {
+    while (current != NULL_INDEX<Index> && tree.pool.key[current] != key) {
         parent = current;
         if (key < tree.pool.key[current]) {
             isLeftChild = true;
@@ -155,24 +195,24 @@ void BinarySearchTree_delete(BinarySearchTree &tree, const float &key) {
             current = tree.pool.right[current];
         }
     }
-    if (current == -1) {
-        std::cerr << "Error: Key " << key << " not found." << std::endl;
+    if (current == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Key " << key << " not found.");
         return;
     }
     
     // Case 1: Node is a leaf.
-    if (tree.pool.left[current] == -1 && tree.pool.right[current] == -1) {
+    if (tree.pool.left[current] == NULL_INDEX<Index> && tree.pool.right[current] == NULL_INDEX<Index>) {
         if (current == tree.root)
-            tree.root = -1;
+            tree.root = NULL_INDEX<Index>;
         else if (isLeftChild)
-            tree.pool.left[parent] = -1;
+            tree.pool.left[parent] = NULL_INDEX<Index>;
         else
-            tree.pool.right[parent] = -1;
+            tree.pool.right[parent] = NULL_INDEX<Index>;
         BinarySearchTree_deallocateNode(tree, current);
     }
     // Case 2: Node has one child.
-    else if (tree.pool.left[current] == -1 || tree.pool.right[current] == -1) {
-        int child = (tree.pool.left[current] != -1) ? tree.pool.left[current] : tree.pool.right[current];
+    else if (tree.pool.left[current] == NULL_INDEX<Index> || tree.pool.right[current] == NULL_INDEX<Index>) {
+        Index child = (tree.pool.left[current] != NULL_INDEX<Index>) ? tree.pool.left[current] : tree.pool.right[current];
         if (current == tree.root)
             tree.root = child;
         else if (isLeftChild)
@@ -184,22 +224,22 @@ void BinarySearchTree_delete(BinarySearchTree &tree, const float &key) {
     // Case 3: Node has two children.
     else {
         // Find the in-order successor (minimum node in right subtree).
-        int successorParent = current;
-        int successor = tree.pool.right[current];
-        while (tree.pool.left[successor] != -1) {
+        Index successorParent = current;
+        Index successor = tree.pool.right[current];
+        while (tree.pool.left[successor] != NULL_INDEX<Index>) {
             successorParent = successor;
             successor = tree.pool.left[successor];
         }
         // Copy the successor's key into the current node.
         tree.pool.key[current] = tree.pool.key[successor];
         // Remove the successor node.
-        if (tree.pool.left[successor] == -1 && tree.pool.right[successor] == -1) {
+        if (tree.pool.left[successor] == NULL_INDEX<Index> && tree.pool.right[successor] == NULL_INDEX<Index>) {
             if (tree.pool.left[successorParent] == successor)
-                tree.pool.left[successorParent] = -1;
+                tree.pool.left[successorParent] = NULL_INDEX<Index>;
             else
-                tree.pool.right[successorParent] = -1;
+                tree.pool.right[successorParent] = NULL_INDEX<Index>;
         } else {
-            int child = (tree.pool.left[successor] != -1) ? tree.pool.left[successor] : tree.pool.right[successor];
+            Index child = (tree.pool.left[successor] != NULL_INDEX<Index>) ? tree.pool.left[successor] : tree.pool.right[successor];
             if (tree.pool.left[successorParent] == successor)
                 tree.pool.left[successorParent] = child;
             else
@@ -209,26 +249,503 @@ void BinarySearchTree_delete(BinarySearchTree &tree, const float &key) {
     }
 }
 
-// In-order traversal helper for the BinarySearchTree.
-void BinarySearchTree_inOrder(const BinarySearchTree &tree, int node_idx) {
-    if (node_idx == -1)
+// Find the node with the smallest key not less than key.
+// Returns the node index via result, or NULL_INDEX if every key is smaller.
+template <typename T, typename Index>
+void BinarySearchTree_lowerBound(const BinarySearchTree<T, Index> &tree, const T &key, Index &result) {
+    result = NULL_INDEX<Index>;
+    Index current = tree.root;
+    while (current != NULL_INDEX<Index>) {
+        if (key < tree.pool.key[current] || key == tree.pool.key[current]) {
+            result = current;  // Candidate; look for a smaller one on the left.
+            current = tree.pool.left[current];
+        } else {
+            current = tree.pool.right[current];
+        }
+    }
+}
+
+// Find the node with the smallest key greater than key.
+// Returns the node index via result, or NULL_INDEX if no key is greater.
+template <typename T, typename Index>
+void BinarySearchTree_upperBound(const BinarySearchTree<T, Index> &tree, const T &key, Index &result) {
+    result = NULL_INDEX<Index>;
+    Index current = tree.root;
+    while (current != NULL_INDEX<Index>) {
+        if (key < tree.pool.key[current]) {
+            result = current;  // Candidate; look for a smaller one on the left.
+            current = tree.pool.left[current];
+        } else {
+            current = tree.pool.right[current];
+        }
+    }
+}
+
+// Forward in-order iterator over a BinarySearchTree.
+// The ancestors still to be visited are kept on an explicit stack whose
+// top is the current node, so advancing is O(1) amortized and degenerate
+// trees cannot overflow the call stack.
+template <typename Index = int>
+struct BinarySearchTreeIterator {
+    std::vector<Index> pending; // Current node on top, then later ancestors.
+};
+
+// Push node_idx and its chain of left descendants onto the iterator stack.
+template <typename T, typename Index>
+void BinarySearchTreeIterator_pushLeft(const BinarySearchTree<T, Index> &tree, BinarySearchTreeIterator<Index> &it, Index node_idx) {
+    while (node_idx != NULL_INDEX<Index>) {
+        it.pending.push_back(node_idx);
+        node_idx = tree.pool.left[node_idx];
+    }
+}
+
+// Position the iterator at the smallest key in the subtree rooted at node_idx.
+template <typename T, typename Index>
+void BinarySearchTreeIterator_begin(const BinarySearchTree<T, Index> &tree, BinarySearchTreeIterator<Index> &it, Index node_idx) {
+    it.pending.clear();
+    BinarySearchTreeIterator_pushLeft(tree, it, node_idx);
+}
+
+// Position the iterator at the first key not less than key (the lower bound).
+template <typename T, typename Index>
+void BinarySearchTreeIterator_seek(const BinarySearchTree<T, Index> &tree, BinarySearchTreeIterator<Index> &it, const T &key) {
+    it.pending.clear();
+    Index current = tree.root;
+    while (current != NULL_INDEX<Index>) {
+        if (key < tree.pool.key[current] || key == tree.pool.key[current]) {
+            it.pending.push_back(current);  // Visited after everything in its left subtree.
+            current = tree.pool.left[current];
+        } else {
+            current = tree.pool.right[current];
+        }
+    }
+}
+
+// Check whether the iterator points at a node.
+template <typename Index>
+bool BinarySearchTreeIterator_valid(const BinarySearchTreeIterator<Index> &it) {
+    return !it.pending.empty();
+}
+
+// Index of the node the iterator points at, or NULL_INDEX past the end.
+template <typename Index>
+Index BinarySearchTreeIterator_node(const BinarySearchTreeIterator<Index> &it) {
+    return it.pending.empty() ? NULL_INDEX<Index> : it.pending.back();
+}
+
+// Advance the iterator to the next key in order.
+template <typename T, typename Index>
+void BinarySearchTreeIterator_next(const BinarySearchTree<T, Index> &tree, BinarySearchTreeIterator<Index> &it) {
+    if (it.pending.empty())
         return;
-    BinarySearchTree_inOrder(tree, tree.pool.left[node_idx]);
-    std::cout << tree.pool.key[node_idx] << " ";
-    BinarySearchTree_inOrder(tree, tree.pool.right[node_idx]);
+    Index node_idx = it.pending.back();
+    it.pending.pop_back();
+    BinarySearchTreeIterator_pushLeft(tree, it, tree.pool.right[node_idx]);
+}
+
+// Visit every key in [lo, hi] in ascending order, stopping early once keys exceed hi.
+// The visitor receives the key and its node index.
+template <typename T, typename Index, typename Visitor>
+void BinarySearchTree_range(const BinarySearchTree<T, Index> &tree, const T &lo, const T &hi, Visitor &&visit) {
+    BinarySearchTreeIterator<Index> it;
+    for (BinarySearchTreeIterator_seek(tree, it, lo); BinarySearchTreeIterator_valid(it);
+         BinarySearchTreeIterator_next(tree, it)) {
+        Index node_idx = BinarySearchTreeIterator_node(it);
+        if (hi < tree.pool.key[node_idx])
+            break;
+        visit(tree.pool.key[node_idx], node_idx);
+    }
+}
+
+// In-order traversal helper for the BinarySearchTree.
+// Iterative, so degenerate (list-shaped) trees cannot overflow the call stack.
+template <typename T, typename Index>
+void BinarySearchTree_inOrder(const BinarySearchTree<T, Index> &tree, Index node_idx) {
+    BinarySearchTreeIterator<Index> it;
+    for (BinarySearchTreeIterator_begin(tree, it, node_idx); BinarySearchTreeIterator_valid(it);
+         BinarySearchTreeIterator_next(tree, it))
+        std::cout << tree.pool.key[BinarySearchTreeIterator_node(it)] << " ";
 }
 
 // Print the BinarySearchTree using in-order traversal.
-void BinarySearchTree_printInOrder(const BinarySearchTree &tree) {
+template <typename T, typename Index>
+void BinarySearchTree_printInOrder(const BinarySearchTree<T, Index> &tree) {
     std::cout << "BinarySearchTree In-Order: ";
     BinarySearchTree_inOrder(tree, tree.root);
     std::cout << std::endl;
 }
 
+// Deleter for cache-line aligned arrays of trivially copyable values.
+template <typename T>
+struct AlignedDeleter {
+    void operator()(T *ptr) const {
+        ::operator delete[](ptr, std::align_val_t{64});
+    }
+};
+
+// Read-only search index built from a BinarySearchTree by freezing it.
+// Keys are laid out in Eytzinger (BFS) order: slot 0 is unused and the
+// children of slot k are 2k and 2k + 1. The first levels of every search
+// share the same few cache lines, and the descendants a few levels below
+// slot k are contiguous and cache-line aligned, so they can be prefetched
+// while the current comparisons are still in flight.
+template <typename T, typename Index = int>
+struct BinarySearchTreeIndex {
+    static_assert(std::is_trivially_copyable_v<T>, "Frozen keys are stored in raw aligned memory.");
+
+    size_t size{0};                                       // Number of keys.
+    std::unique_ptr<T[], AlignedDeleter<T>> key{nullptr}; // Keys in Eytzinger order (1-based).
+    std::unique_ptr<Index[]> node{nullptr};               // Tree node index of each slot at freeze time.
+};
+
+// Keys per cache line, rounded down to a power of two (at least one).
+// Slot k's descendants log2(stride) levels down start at slot stride * k.
+template <typename T>
+constexpr size_t BinarySearchTreeIndex_stride = std::bit_floor(std::max<size_t>(1, 64 / sizeof(T)));
+
+// Fill Eytzinger slot k (and its subtree) from the sorted arrays, consuming them in order.
+template <typename T, typename Index>
+void BinarySearchTreeIndex_fill(BinarySearchTreeIndex<T, Index> &index, const std::vector<T> &keys,
+                                const std::vector<Index> &nodes, size_t &next, size_t k) {
+    if (k > index.size)
+        return;
+    BinarySearchTreeIndex_fill(index, keys, nodes, next, 2 * k);
+    index.key[k] = keys[next];
+    index.node[k] = nodes[next];
+    ++next;
+    BinarySearchTreeIndex_fill(index, keys, nodes, next, 2 * k + 1);
+}
+
+// Freeze the tree into a read-only Eytzinger-layout search index.
+// The tree itself is left unchanged; later updates are not reflected in the index.
+template <typename T, typename Index>
+void BinarySearchTree_freeze(const BinarySearchTree<T, Index> &tree, BinarySearchTreeIndex<T, Index> &index) {
+    // Collect keys in order.
+    std::vector<T> keys;
+    std::vector<Index> nodes;
+    BinarySearchTreeIterator<Index> it;
+    for (BinarySearchTreeIterator_begin(tree, it, tree.root); BinarySearchTreeIterator_valid(it);
+         BinarySearchTreeIterator_next(tree, it)) {
+        keys.push_back(tree.pool.key[BinarySearchTreeIterator_node(it)]);
+        nodes.push_back(BinarySearchTreeIterator_node(it));
+    }
+
+    // Rounded up to whole cache lines.
+    const size_t bytes = ((keys.size() + 1) * sizeof(T) + 63) & ~static_cast<size_t>(63);
+    index.size = keys.size();
+    index.key.reset(static_cast<T *>(::operator new[](bytes, std::align_val_t{64})));
+    index.node = std::make_unique<Index[]>(keys.size() + 1);
+    index.key[0] = T{};
+    index.node[0] = NULL_INDEX<Index>;
+    size_t next = 0;
+    BinarySearchTreeIndex_fill(index, keys, nodes, next, 1);
+}
+
+// Search for a key in the frozen index.
+// Returns the tree node index (as of the freeze) via result if found; otherwise, result is set to NULL_INDEX.
+template <typename T, typename Index>
+void BinarySearchTreeIndex_search(const BinarySearchTreeIndex<T, Index> &index, const T &key, Index &result) {
+    const T *keys = index.key.get();
+    size_t k = 1;
+    while (k <= index.size) {
+#if defined(__GNUC__)
+        // Only prefetch slots that exist; forming a pointer past the end is undefined.
+        if (BinarySearchTreeIndex_stride<T> * k <= index.size)
+            __builtin_prefetch(keys + BinarySearchTreeIndex_stride<T> * k);
+#endif
+        // Branchless descent: go right when the slot key is smaller.
+        k = 2 * k + static_cast<size_t>(keys[k] < key);
+    }
+    // Undo the trailing right turns plus one left turn to land on the lower bound.
+    k >>= std::countr_one(k) + 1;
+    result = (k != 0 && keys[k] == key) ? index.node[k] : NULL_INDEX<Index>;
+}
+
+// Structure representing a self-balancing AVLTree using the same free-node
+// pool layout as BinarySearchTree, plus a height per node. Every subtree
+// keeps the heights of its two children within one of each other, so
+// insert, delete and search are O(log n) in the worst case, including for
+// sorted input.
+template <typename T, typename Index = int>
+struct AVLTree {
+    Index root{NULL_INDEX<Index>}; // Index of the root node.
+
+    // Free-node pool holding node arrays and their occupancy allocator.
+    struct {
+        std::unique_ptr<T[]> key{nullptr};               // Node key values.
+        std::unique_ptr<Index[]> left{nullptr};          // Left child indices.
+        std::unique_ptr<Index[]> right{nullptr};         // Right child indices.
+        std::unique_ptr<std::uint8_t[]> height{nullptr}; // Subtree heights (leaf = 1); always far below 256.
+        NodePool<Index> slots;                           // Occupancy bitmap allocator.
+        bool growable{true};                             // Grow the pool when it runs out of free nodes.
+    } pool;
+};
+
+// Initialize the AVLTree with N nodes.
+// All nodes are initially free.
+template <typename T, typename Index>
+void AVLTree_init(AVLTree<T, Index> &tree, const size_t &N) {
+    tree.root = NULL_INDEX<Index>;
+    NodePool_init(tree.pool.slots, N);
+    tree.pool.key = make_payload_array<T>(N);
+    tree.pool.left = std::make_unique<Index[]>(N);
+    tree.pool.right = std::make_unique<Index[]>(N);
+    tree.pool.height = std::make_unique<std::uint8_t[]>(N);
+
+    for (size_t i = 0; i < N; ++i) {
+        tree.pool.left[i] = NULL_INDEX<Index>;
+        tree.pool.right[i] = NULL_INDEX<Index>;
+        tree.pool.height[i] = 0;
+    }
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool AVLTree_growPool(AVLTree<T, Index> &tree) {
+    const size_t old_size = tree.pool.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(tree.pool.slots, new_size))
+        return false;
+
+    auto key = make_payload_array<T>(new_size);
+    auto left = std::make_unique<Index[]>(new_size);
+    auto right = std::make_unique<Index[]>(new_size);
+    auto height = std::make_unique<std::uint8_t[]>(new_size);
+
+    std::move(tree.pool.key.get(), tree.pool.key.get() + old_size, key.get());
+    std::copy_n(tree.pool.left.get(), old_size, left.get());
+    std::copy_n(tree.pool.right.get(), old_size, right.get());
+    std::copy_n(tree.pool.height.get(), old_size, height.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        left[i] = NULL_INDEX<Index>;
+        right[i] = NULL_INDEX<Index>;
+        height[i] = 0;
+    }
+
+    tree.pool.key = std::move(key);
+    tree.pool.left = std::move(left);
+    tree.pool.right = std::move(right);
+    tree.pool.height = std::move(height);
+    return true;
+}
+
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
+// Initializes the node as a leaf with the provided key and returns its index via node_idx.
+template <typename T, typename Index>
+void AVLTree_allocateNode(AVLTree<T, Index> &tree, const T &key, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(tree.pool.slots) &&
+        !(tree.pool.growable && AVLTree_growPool(tree))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
+        return;
+    }
+    // Take the lowest free node.
+    NodePool_allocate(tree.pool.slots, node_idx);
+
+    // Initialize the node.
+    tree.pool.key[node_idx] = key;
+    tree.pool.left[node_idx] = NULL_INDEX<Index>;
+    tree.pool.right[node_idx] = NULL_INDEX<Index>;
+    tree.pool.height[node_idx] = 1;
+}
+
+// Deallocate a node by returning it to the pool.
+template <typename T, typename Index>
+void AVLTree_deallocateNode(AVLTree<T, Index> &tree, const size_t &idx) {
+    if (idx >= tree.pool.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
+        return;
+    }
+    if (!NodePool_isAllocated(tree.pool.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
+        return;
+    }
+    // Reset node's content.
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        tree.pool.key[idx] = T{}; // Release resources held by the payload.
+    tree.pool.left[idx] = NULL_INDEX<Index>;
+    tree.pool.right[idx] = NULL_INDEX<Index>;
+    tree.pool.height[idx] = 0;
+
+    // Return the node to the pool.
+    NodePool_free(tree.pool.slots, idx);
+}
+
+// Height of the subtree rooted at node_idx (0 for an empty subtree).
+template <typename T, typename Index>
+int AVLTree_height(const AVLTree<T, Index> &tree, Index node_idx) {
+    return (node_idx == NULL_INDEX<Index>) ? 0 : tree.pool.height[node_idx];
+}
+
+// Recompute a node's height from its children.
+template <typename T, typename Index>
+void AVLTree_updateHeight(AVLTree<T, Index> &tree, Index node_idx) {
+    tree.pool.height[node_idx] = static_cast<std::uint8_t>(1 + std::max(AVLTree_height(tree, tree.pool.left[node_idx]),
+                                                                     AVLTree_height(tree, tree.pool.right[node_idx])));
+}
+
+// Rotate the subtree rooted at node_idx to the right; returns the new subtree root.
+template <typename T, typename Index>
+Index AVLTree_rotateRight(AVLTree<T, Index> &tree, Index node_idx) {
+    Index pivot = tree.pool.left[node_idx];
+    tree.pool.left[node_idx] = tree.pool.right[pivot];
+    tree.pool.right[pivot] = node_idx;
+    AVLTree_updateHeight(tree, node_idx);
+    AVLTree_updateHeight(tree, pivot);
+    return pivot;
+}
+
+// Rotate the subtree rooted at node_idx to the left; returns the new subtree root.
+template <typename T, typename Index>
+Index AVLTree_rotateLeft(AVLTree<T, Index> &tree, Index node_idx) {
+    Index pivot = tree.pool.right[node_idx];
+    tree.pool.right[node_idx] = tree.pool.left[pivot];
+    tree.pool.left[pivot] = node_idx;
+    AVLTree_updateHeight(tree, node_idx);
+    AVLTree_updateHeight(tree, pivot);
+    return pivot;
+}
+
+// Restore the AVL property at node_idx after one of its subtrees changed
+// height by one; returns the new subtree root.
+template <typename T, typename Index>
+Index AVLTree_rebalance(AVLTree<T, Index> &tree, Index node_idx) {
+    AVLTree_updateHeight(tree, node_idx);
+    int balance = AVLTree_height(tree, tree.pool.left[node_idx]) - AVLTree_height(tree, tree.pool.right[node_idx]);
+    if (balance > 1) {
+        // Left-heavy: a left-right case first becomes left-left.
+        Index left = tree.pool.left[node_idx];
+        if (AVLTree_height(tree, tree.pool.left[left]) < AVLTree_height(tree, tree.pool.right[left]))
+            tree.pool.left[node_idx] = AVLTree_rotateLeft(tree, left);
+        return AVLTree_rotateRight(tree, node_idx);
+    }
+    if (balance < -1) {
+        // Right-heavy: a right-left case first becomes right-right.
+        Index right = tree.pool.right[node_idx];
+        if (AVLTree_height(tree, tree.pool.right[right]) < AVLTree_height(tree, tree.pool.left[right]))
+            tree.pool.right[node_idx] = AVLTree_rotateRight(tree, right);
+        return AVLTree_rotateLeft(tree, node_idx);
+    }
+    return node_idx;
+}
+
+// Insert new_node into the subtree rooted at node_idx; returns the new subtree root.
+// Recursion depth is bounded by the tree height, which is O(log n).
+template <typename T, typename Index>
+Index AVLTree_insertAt(AVLTree<T, Index> &tree, Index node_idx, Index new_node) {
+    if (node_idx == NULL_INDEX<Index>)
+        return new_node;
+    if (tree.pool.key[new_node] < tree.pool.key[node_idx])
+        tree.pool.left[node_idx] = AVLTree_insertAt(tree, tree.pool.left[node_idx], new_node);
+    else
+        tree.pool.right[node_idx] = AVLTree_insertAt(tree, tree.pool.right[node_idx], new_node);
+    return AVLTree_rebalance(tree, node_idx);
+}
+
+// Insert a key into the AVLTree.
+template <typename T, typename Index>
+void AVLTree_insert(AVLTree<T, Index> &tree, const T &key) {
+    Index new_node = NULL_INDEX<Index>;
+    AVLTree_allocateNode(tree, key, new_node);
+    if (new_node == NULL_INDEX<Index>)
+        return;
+    tree.root = AVLTree_insertAt(tree, tree.root, new_node);
+}
+
+// Search for a key in the AVLTree.
+// Returns the node index via result if found; otherwise, result is set to NULL_INDEX.
+template <typename T, typename Index>
+void AVLTree_search(const AVLTree<T, Index> &tree, const T &key, Index &result) {
+    Index current = tree.root;
+    while (current != NULL_INDEX<Index>) {
+        if (tree.pool.key[current] == key) {
+            result = current;
+            return;
+        }
+        if (key < tree.pool.key[current])
+            current = tree.pool.left[current];
+        else
+            current = tree.pool.right[current];
+    }
+    result = NULL_INDEX<Index>;
+}
+
+// Unlink the minimum node of the subtree rooted at node_idx into min_node;
+// returns the new subtree root.
+template <typename T, typename Index>
+Index AVLTree_detachMin(AVLTree<T, Index> &tree, Index node_idx, Index &min_node) {
+    if (tree.pool.left[node_idx] == NULL_INDEX<Index>) {
+        min_node = node_idx;
+        return tree.pool.right[node_idx];
+    }
+    tree.pool.left[node_idx] = AVLTree_detachMin(tree, tree.pool.left[node_idx], min_node);
+    return AVLTree_rebalance(tree, node_idx);
+}
+
+// Delete one node with the given key from the subtree rooted at node_idx;
+// returns the new subtree root. found is set if a node was removed.
+template <typename T, typename Index>
+Index AVLTree_deleteAt(AVLTree<T, Index> &tree, Index node_idx, const T &key, bool &found) {
+    if (node_idx == NULL_INDEX<Index>)
+        return NULL_INDEX<Index>;
+    if (key < tree.pool.key[node_idx]) {
+        tree.pool.left[node_idx] = AVLTree_deleteAt(tree, tree.pool.left[node_idx], key, found);
+    } else if (tree.pool.key[node_idx] < key) {
+        tree.pool.right[node_idx] = AVLTree_deleteAt(tree, tree.pool.right[node_idx], key, found);
+    } else {
+        found = true;
+        Index left = tree.pool.left[node_idx];
+        Index right = tree.pool.right[node_idx];
+        AVLTree_deallocateNode(tree, node_idx);
+        if (left == NULL_INDEX<Index>)
+            return right;
+        if (right == NULL_INDEX<Index>)
+            return left;
+        // Two children: the in-order successor takes this node's place.
+        Index successor = NULL_INDEX<Index>;
+        right = AVLTree_detachMin(tree, right, successor);
+        tree.pool.left[successor] = left;
+        tree.pool.right[successor] = right;
+        return AVLTree_rebalance(tree, successor);
+    }
+    return AVLTree_rebalance(tree, node_idx);
+}
+
+// Delete a node with the specified key from the AVLTree.
+template <typename T, typename Index>
+void AVLTree_delete(AVLTree<T, Index> &tree, const T &key) {
+    bool found = false;
+    tree.root = AVLTree_deleteAt(tree, tree.root, key, found);
+    if (!found)
+        CONTAINER_ERROR(ContainerError::NotFound, "Key " << key << " not found.");
+}
+
+// In-order traversal helper for the AVLTree.
+template <typename T, typename Index>
+void AVLTree_inOrder(const AVLTree<T, Index> &tree, Index node_idx) {
+    if (node_idx == NULL_INDEX<Index>)
+        return;
+    AVLTree_inOrder(tree, tree.pool.left[node_idx]);
+    std::cout << tree.pool.key[node_idx] << " ";
+    AVLTree_inOrder(tree, tree.pool.right[node_idx]);
+}
+
+// Print the AVLTree using in-order traversal.
+template <typename T, typename Index>
+void AVLTree_printInOrder(const AVLTree<T, Index> &tree) {
+    std::cout << "AVLTree In-Order: ";
+    AVLTree_inOrder(tree, tree.root);
+    std::cout << std::endl;
+}
+
 // Demonstration of BinarySearchTree operations.
 int main() {
     constexpr size_t N = 20;
-    BinarySearchTree tree;
+    BinarySearchTree<float> tree;
     
     // Initialize the BinarySearchTree with a pool of N nodes.
     BinarySearchTree_init(tree, N);
@@ -252,9 +769,64 @@ int main() {
     else
         std::cout << "Key 60 not found." << std::endl;
     
+    // Ordered queries without recursion or printing in the loop.
+    BinarySearchTree_lowerBound(tree, 55.0f, result);
+    std::cout << "Lower bound of 55: " << tree.pool.key[result] << std::endl;  // Expected: 60
+    BinarySearchTree_upperBound(tree, 60.0f, result);
+    std::cout << "Upper bound of 60: " << tree.pool.key[result] << std::endl;  // Expected: 70
+    
+    float scanned[8];
+    size_t scanned_count = 0;
+    BinarySearchTree_range(tree, 25.0f, 65.0f, [&scanned, &scanned_count](float key, int) {
+        scanned[scanned_count++] = key;
+    });
+    std::cout << "Range [25, 65]: ";
+    for (size_t i = 0; i < scanned_count; ++i)
+        std::cout << scanned[i] << " ";
+    std::cout << std::endl;  // Expected: 30 40 50 60
+    
+    // Freeze into a read-only index and query it.
+    BinarySearchTreeIndex<float> index;
+    BinarySearchTree_freeze(tree, index);
+    BinarySearchTreeIndex_search(index, 60.0f, result);
+    std::cout << "Frozen index: key 60 at node index " << result << std::endl;  // Same node as above.
+    BinarySearchTreeIndex_search(index, 65.0f, result);
+    std::cout << "Frozen index: key 65 at node index " << result << std::endl;  // Expected: -1
+    
     // Delete a key.
     BinarySearchTree_delete(tree, 30.0f);
     BinarySearchTree_printInOrder(tree);  // Expected output: 20 40 50 60 70 80
     
+    // Insert past the initial capacity; the pool grows on demand.
+    for (int i = 0; i < static_cast<int>(N); ++i)
+        BinarySearchTree_insert(tree, static_cast<float>(100 + i));
+    std::cout << "Pool size after growth: " << tree.pool.slots.size << std::endl;
+    BinarySearchTree_printInOrder(tree);  // Expected output: 20 40 50 60 70 80 100 ... 119
+    
+    // Key and index types are template parameters: string keys linked with
+    // 16-bit indices.
+    AVLTree<std::string, std::uint16_t> words;
+    AVLTree_init(words, 4);
+    for (const char *word : {"pear", "apple", "fig", "kiwi", "banana", "cherry"})
+        AVLTree_insert(words, std::string(word));
+    AVLTree_delete(words, std::string("fig"));
+    AVLTree_printInOrder(words);  // Expected output: apple banana cherry kiwi pear
+    
+    // Sorted keys keep the AVLTree balanced instead of degrading into a list.
+    AVLTree<float> balanced;
+    AVLTree_init(balanced, N);
+    for (int i = 1; i <= 31; ++i)
+        AVLTree_insert(balanced, static_cast<float>(i));
+    std::cout << "AVLTree height after 31 sorted inserts: " << AVLTree_height(balanced, balanced.root) << std::endl;  // Expected: 5
+    
+    AVLTree_search(balanced, 17.0f, result);
+    if (result != -1)
+        std::cout << "Key 17 found at node index: " << result << std::endl;
+    
+    for (int i = 1; i <= 31; i += 2)
+        AVLTree_delete(balanced, static_cast<float>(i));
+    AVLTree_printInOrder(balanced);  // Expected output: 2 4 6 ... 30
+    std::cout << "AVLTree height after deletions: " << AVLTree_height(balanced, balanced.root) << std::endl;
+    
     return 0;
 }
@@ -0,0 +1,577 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Maximum number of keys per node. Keys of a node fill two cache lines.
+constexpr int BPLUS_MAX_KEYS = 32;
+// Minimum number of keys per non-root node before it is rebalanced.
+constexpr int BPLUS_MIN_KEYS = BPLUS_MAX_KEYS / 2 - 1;
+
+// Deleter for cache-line aligned float arrays.
+struct AlignedFloatDeleter {
+    void operator()(float *ptr) const {
+        ::operator delete[](ptr, std::align_val_t{64});
+    }
+};
+
+// Structure representing a BPlusTree (sorted set of keys) using a free-node pool.
+// Each pool node holds up to BPLUS_MAX_KEYS sorted keys. Unused key slots
+// hold +infinity, so a node is always searched over its full key block
+// with SIMD compares and no count check. Internal nodes route with
+// BPLUS_MAX_KEYS + 1 children; leaves are chained in key order, so range
+// scans read leaves sequentially.
+struct BPlusTree {
+    int root{-1};       // Index of the root node.
+    int first_leaf{-1}; // Index of the leftmost leaf.
+
+    // Free-node pool holding node arrays and their occupancy allocator.
+    struct {
+        std::unique_ptr<float[], AlignedFloatDeleter> keys{nullptr}; // BPLUS_MAX_KEYS keys per node.
+        std::unique_ptr<int[]> children{nullptr};                    // BPLUS_MAX_KEYS + 1 child indices per node.
+        std::unique_ptr<int[]> count{nullptr};                       // Number of keys in each node.
+        std::unique_ptr<bool[]> leaf{nullptr};                       // Leaf flags.
+        std::unique_ptr<int[]> next_leaf{nullptr};                   // Next leaf in key order.
+        NodePool<int> slots;                                         // Occupancy bitmap allocator.
+        bool growable{true};                                         // Grow the pool when it runs out of free nodes.
+    } pool;
+};
+
+// Pointer to the key block of a node.
+float *BPlusTree_keys(BPlusTree &tree, int node_idx) {
+    return tree.pool.keys.get() + static_cast<size_t>(node_idx) * BPLUS_MAX_KEYS;
+}
+
+const float *BPlusTree_keys(const BPlusTree &tree, int node_idx) {
+    return tree.pool.keys.get() + static_cast<size_t>(node_idx) * BPLUS_MAX_KEYS;
+}
+
+// Pointer to the child block of a node.
+int *BPlusTree_children(BPlusTree &tree, int node_idx) {
+    return tree.pool.children.get() + static_cast<size_t>(node_idx) * (BPLUS_MAX_KEYS + 1);
+}
+
+const int *BPlusTree_children(const BPlusTree &tree, int node_idx) {
+    return tree.pool.children.get() + static_cast<size_t>(node_idx) * (BPLUS_MAX_KEYS + 1);
+}
+
+// Reset a node's key and child blocks to the empty state.
+void BPlusTree_clearNode(BPlusTree &tree, int node_idx) {
+    std::fill_n(BPlusTree_keys(tree, node_idx), BPLUS_MAX_KEYS, std::numeric_limits<float>::infinity());
+    std::fill_n(BPlusTree_children(tree, node_idx), BPLUS_MAX_KEYS + 1, -1);
+    tree.pool.count[node_idx] = 0;
+    tree.pool.leaf[node_idx] = false;
+    tree.pool.next_leaf[node_idx] = -1;
+}
+
+// Count the keys in a node's key block that are smaller than key
+// (or smaller than or equal to key, if inclusive).
+// The +infinity padding means the whole block can be compared at once.
+// A +infinity key also counts the padding, so the result is clamped to
+// the node's count of keys.
+int BPlusTree_rank(const float *keys, const int count, const float key, const bool inclusive) {
+    int rank = 0;
+#if defined(__AVX2__)
+    const __m256 needle = _mm256_set1_ps(key);
+    for (int i = 0; i < BPLUS_MAX_KEYS; i += 8) {
+        __m256 block = _mm256_load_ps(keys + i);
+        __m256 mask = inclusive ? _mm256_cmp_ps(block, needle, _CMP_LE_OQ)
+                                : _mm256_cmp_ps(block, needle, _CMP_LT_OQ);
+        rank += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(mask)));
+    }
+#elif defined(__SSE2__)
+    const __m128 needle = _mm_set1_ps(key);
+    for (int i = 0; i < BPLUS_MAX_KEYS; i += 4) {
+        __m128 block = _mm_load_ps(keys + i);
+        __m128 mask = inclusive ? _mm_cmple_ps(block, needle) : _mm_cmplt_ps(block, needle);
+        rank += std::popcount(static_cast<unsigned>(_mm_movemask_ps(mask)));
+    }
+#else
+    for (int i = 0; i < BPLUS_MAX_KEYS; ++i)
+        rank += inclusive ? (keys[i] <= key) : (keys[i] < key);
+#endif
+    return std::min(rank, count);
+}
+
+// Initialize the BPlusTree with N nodes.
+// All nodes are initially free.
+void BPlusTree_init(BPlusTree &tree, const size_t &N) {
+    tree.root = -1;
+    tree.first_leaf = -1;
+    NodePool_init(tree.pool.slots, N);
+    tree.pool.keys.reset(static_cast<float *>(
+        ::operator new[](N * BPLUS_MAX_KEYS * sizeof(float), std::align_val_t{64})));
+    tree.pool.children = std::make_unique<int[]>(N * (BPLUS_MAX_KEYS + 1));
+    tree.pool.count = std::make_unique<int[]>(N);
+    tree.pool.leaf = std::make_unique<bool[]>(N);
+    tree.pool.next_leaf = std::make_unique<int[]>(N);
+
+    for (size_t i = 0; i < N; ++i)
+        BPlusTree_clearNode(tree, static_cast<int>(i));
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+bool BPlusTree_growPool(BPlusTree &tree) {
+    const size_t old_size = tree.pool.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (new_size > static_cast<size_t>(std::numeric_limits<int>::max()) / (BPLUS_MAX_KEYS + 1)) {
+        CONTAINER_ERROR(ContainerError::Full, "Node pool cannot grow beyond the index range.");
+        return false;
+    }
+    if (!NodePool_grow(tree.pool.slots, new_size))
+        return false;
+
+    std::unique_ptr<float[], AlignedFloatDeleter> keys(static_cast<float *>(
+        ::operator new[](new_size * BPLUS_MAX_KEYS * sizeof(float), std::align_val_t{64})));
+    auto children = std::make_unique<int[]>(new_size * (BPLUS_MAX_KEYS + 1));
+    auto count = std::make_unique<int[]>(new_size);
+    auto leaf = std::make_unique<bool[]>(new_size);
+    auto next_leaf = std::make_unique<int[]>(new_size);
+
+    std::copy_n(tree.pool.keys.get(), old_size * BPLUS_MAX_KEYS, keys.get());
+    std::copy_n(tree.pool.children.get(), old_size * (BPLUS_MAX_KEYS + 1), children.get());
+    std::copy_n(tree.pool.count.get(), old_size, count.get());
+    std::copy_n(tree.pool.leaf.get(), old_size, leaf.get());
+    std::copy_n(tree.pool.next_leaf.get(), old_size, next_leaf.get());
+
+    tree.pool.keys = std::move(keys);
+    tree.pool.children = std::move(children);
+    tree.pool.count = std::move(count);
+    tree.pool.leaf = std::move(leaf);
+    tree.pool.next_leaf = std::move(next_leaf);
+
+    for (size_t i = old_size; i < new_size; ++i)
+        BPlusTree_clearNode(tree, static_cast<int>(i));
+    return true;
+}
+
+// Allocate the lowest free node from the pool as an empty node.
+// Grows the pool first if every node is in use and the pool is growable.
+// Returns the allocated node index via node_idx.
+void BPlusTree_allocateNode(BPlusTree &tree, const bool leaf, int &node_idx) {
+    node_idx = -1;
+    if (NodePool_full(tree.pool.slots) &&
+        !(tree.pool.growable && BPlusTree_growPool(tree))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
+        return;
+    }
+    // Take the lowest free node.
+    NodePool_allocate(tree.pool.slots, node_idx);
+
+    // Initialize the node.
+    BPlusTree_clearNode(tree, node_idx);
+    tree.pool.leaf[node_idx] = leaf;
+}
+
+// Deallocate a node by returning it to the pool.
+void BPlusTree_deallocateNode(BPlusTree &tree, const size_t &idx) {
+    if (idx >= tree.pool.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
+        return;
+    }
+    if (!NodePool_isAllocated(tree.pool.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
+        return;
+    }
+    // Reset node's content.
+    BPlusTree_clearNode(tree, static_cast<int>(idx));
+
+    // Return the node to the pool.
+    NodePool_free(tree.pool.slots, idx);
+}
+
+// Insert key into the subtree rooted at node_idx.
+// If the node had to split, returns true with the separator key and the new
+// right sibling in up_key/up_node. inserted is cleared for duplicate keys.
+bool BPlusTree_insertAt(BPlusTree &tree, int node_idx, const float &key,
+                        float &up_key, int &up_node, bool &inserted) {
+    int pos = BPlusTree_rank(BPlusTree_keys(tree, node_idx), tree.pool.count[node_idx], key, !tree.pool.leaf[node_idx]);
+    float child_key = key;
+    int child_node = -1;
+
+    if (tree.pool.leaf[node_idx]) {
+        if (pos < tree.pool.count[node_idx] && BPlusTree_keys(tree, node_idx)[pos] == key) {
+            inserted = false;
+            return false;
+        }
+    } else {
+        // Descend; nothing to do here unless the child split.
+        if (!BPlusTree_insertAt(tree, BPlusTree_children(tree, node_idx)[pos], key, child_key, child_node, inserted))
+            return false;
+    }
+
+    // The node needs a new key (and, for internal nodes, a new child after it).
+    bool split = false;
+    int target = node_idx;
+    if (tree.pool.count[node_idx] == BPLUS_MAX_KEYS) {
+        // Split first, then insert into whichever half the key belongs to.
+        int right = -1;
+        BPlusTree_allocateNode(tree, tree.pool.leaf[node_idx], right);
+        if (right == -1) {
+            inserted = false;
+            return false;
+        }
+        float *left_keys = BPlusTree_keys(tree, node_idx);
+        float *right_keys = BPlusTree_keys(tree, right);
+        int *left_children = BPlusTree_children(tree, node_idx);
+        int *right_children = BPlusTree_children(tree, right);
+        constexpr int mid = BPLUS_MAX_KEYS / 2;
+        if (tree.pool.leaf[node_idx]) {
+            // Leaves keep every key; the right half's first key is copied up.
+            std::copy(left_keys + mid, left_keys + BPLUS_MAX_KEYS, right_keys);
+            tree.pool.count[right] = BPLUS_MAX_KEYS - mid;
+            up_key = right_keys[0];
+            tree.pool.next_leaf[right] = tree.pool.next_leaf[node_idx];
+            tree.pool.next_leaf[node_idx] = right;
+        } else {
+            // Internal nodes move their middle key up.
+            up_key = left_keys[mid];
+            std::copy(left_keys + mid + 1, left_keys + BPLUS_MAX_KEYS, right_keys);
+            std::copy(left_children + mid + 1, left_children + BPLUS_MAX_KEYS + 1, right_children);
+            std::fill(left_children + mid + 1, left_children + BPLUS_MAX_KEYS + 1, -1);
+            tree.pool.count[right] = BPLUS_MAX_KEYS - mid - 1;
+        }
+        std::fill(left_keys + mid, left_keys + BPLUS_MAX_KEYS, std::numeric_limits<float>::infinity());
+        tree.pool.count[node_idx] = mid;
+        up_node = right;
+        split = true;
+        if (!(child_key < up_key)) {
+            target = right;
+        }
+        pos = BPlusTree_rank(BPlusTree_keys(tree, target), tree.pool.count[target], child_key, !tree.pool.leaf[target]);
+    }
+
+    float *keys = BPlusTree_keys(tree, target);
+    int &count = tree.pool.count[target];
+    std::copy_backward(keys + pos, keys + count, keys + count + 1);
+    keys[pos] = child_key;
+    if (!tree.pool.leaf[target]) {
+        int *children = BPlusTree_children(tree, target);
+        std::copy_backward(children + pos + 1, children + count + 1, children + count + 2);
+        children[pos + 1] = child_node;
+    }
+    ++count;
+    return split;
+}
+
+// Number of nodes that inserting key will allocate: one for every full
+// node at the bottom of the search path (each of them splits), plus a new
+// root if the root splits too. 0 if the key is already present.
+int BPlusTree_nodesNeeded(const BPlusTree &tree, const float &key) {
+    if (tree.root == -1)
+        return 1;
+    int depth = 0;
+    int full_run = 0; // Full nodes at the bottom of the path so far.
+    for (int current = tree.root;; current = BPlusTree_children(tree, current)[
+             BPlusTree_rank(BPlusTree_keys(tree, current), tree.pool.count[current], key, true)]) {
+        const int count = tree.pool.count[current];
+        ++depth;
+        // A node that is not full absorbs the splits below it.
+        full_run = (count == BPLUS_MAX_KEYS) ? full_run + 1 : 0;
+        if (tree.pool.leaf[current]) {
+            const int pos = BPlusTree_rank(BPlusTree_keys(tree, current), count, key, false);
+            if (pos < count && BPlusTree_keys(tree, current)[pos] == key)
+                return 0;
+            break;
+        }
+    }
+    return (full_run == depth) ? full_run + 1 : full_run;
+}
+
+// Insert a key into the BPlusTree. Keys already present are ignored.
+// NaN is rejected, since it has no place in the key order.
+void BPlusTree_insert(BPlusTree &tree, const float &key) {
+    if (std::isnan(key)) {
+        CONTAINER_ERROR(ContainerError::InvalidKey, "NaN cannot be used as a key.");
+        return;
+    }
+    // Make sure every node the insert allocates is available before any
+    // node splits, so a full pool cannot leave a split half unlinked.
+    const size_t needed = static_cast<size_t>(BPlusTree_nodesNeeded(tree, key));
+    while (tree.pool.slots.size - tree.pool.slots.count < needed) {
+        if (!(tree.pool.growable && BPlusTree_growPool(tree))) {
+            CONTAINER_ERROR(ContainerError::Full, "No free node available.");
+            return;
+        }
+    }
+    if (tree.root == -1) {
+        BPlusTree_allocateNode(tree, true, tree.root);
+        if (tree.root == -1)
+            return;
+        tree.first_leaf = tree.root;
+    }
+    float up_key = 0.0f;
+    int up_node = -1;
+    bool inserted = true;
+    if (BPlusTree_insertAt(tree, tree.root, key, up_key, up_node, inserted)) {
+        // The root split: grow the tree by one level.
+        int new_root = -1;
+        BPlusTree_allocateNode(tree, false, new_root);
+        if (new_root == -1)
+            return;
+        BPlusTree_keys(tree, new_root)[0] = up_key;
+        BPlusTree_children(tree, new_root)[0] = tree.root;
+        BPlusTree_children(tree, new_root)[1] = up_node;
+        tree.pool.count[new_root] = 1;
+        tree.root = new_root;
+    }
+}
+
+// Find the leaf that would contain key.
+int BPlusTree_findLeaf(const BPlusTree &tree, const float &key) {
+    int current = tree.root;
+    while (current != -1 && !tree.pool.leaf[current])
+        current = BPlusTree_children(tree, current)[BPlusTree_rank(BPlusTree_keys(tree, current), tree.pool.count[current], key, true)];
+    return current;
+}
+
+// Search for a key in the BPlusTree.
+// Returns the index of the leaf holding the key via result if found; otherwise, result is set to -1.
+void BPlusTree_search(const BPlusTree &tree, const float &key, int &result) {
+    result = -1;
+    if (std::isnan(key))
+        return;
+    int leaf = BPlusTree_findLeaf(tree, key);
+    if (leaf == -1)
+        return;
+    int pos = BPlusTree_rank(BPlusTree_keys(tree, leaf), tree.pool.count[leaf], key, false);
+    if (pos < tree.pool.count[leaf] && BPlusTree_keys(tree, leaf)[pos] == key)
+        result = leaf;
+}
+
+// Visit every key in [lo, hi] in ascending order by walking the leaf chain.
+template <typename Visitor>
+void BPlusTree_range(const BPlusTree &tree, const float &lo, const float &hi, Visitor &&visit) {
+    if (std::isnan(lo) || std::isnan(hi))
+        return;
+    int leaf = BPlusTree_findLeaf(tree, lo);
+    if (leaf == -1)
+        return;
+    int pos = BPlusTree_rank(BPlusTree_keys(tree, leaf), tree.pool.count[leaf], lo, false);
+    while (leaf != -1) {
+        const float *keys = BPlusTree_keys(tree, leaf);
+        for (; pos < tree.pool.count[leaf]; ++pos) {
+            if (hi < keys[pos])
+                return;
+            visit(keys[pos]);
+        }
+        leaf = tree.pool.next_leaf[leaf];
+        pos = 0;
+    }
+}
+
+// Remove the key at position pos from a node, together with the child to
+// its right when the node is internal.
+void BPlusTree_removeAt(BPlusTree &tree, int node_idx, int pos) {
+    float *keys = BPlusTree_keys(tree, node_idx);
+    int &count = tree.pool.count[node_idx];
+    std::copy(keys + pos + 1, keys + count, keys + pos);
+    keys[count - 1] = std::numeric_limits<float>::infinity();
+    if (!tree.pool.leaf[node_idx]) {
+        int *children = BPlusTree_children(tree, node_idx);
+        std::copy(children + pos + 2, children + count + 1, children + pos + 1);
+        children[count] = -1;
+    }
+    --count;
+}
+
+// Restore the minimum fill of the child at position idx of parent by
+// borrowing a key from a sibling or merging with it.
+void BPlusTree_fixChild(BPlusTree &tree, int parent, int idx) {
+    float *parent_keys = BPlusTree_keys(tree, parent);
+    int *parent_children = BPlusTree_children(tree, parent);
+    int child = parent_children[idx];
+    int left = (idx > 0) ? parent_children[idx - 1] : -1;
+    int right = (idx < tree.pool.count[parent]) ? parent_children[idx + 1] : -1;
+    bool leaf = tree.pool.leaf[child];
+    float *child_keys = BPlusTree_keys(tree, child);
+    int *child_children = BPlusTree_children(tree, child);
+    int &child_count = tree.pool.count[child];
+
+    if (left != -1 && tree.pool.count[left] > BPLUS_MIN_KEYS) {
+        // Borrow the last key of the left sibling.
+        float *left_keys = BPlusTree_keys(tree, left);
+        int *left_children = BPlusTree_children(tree, left);
+        int &left_count = tree.pool.count[left];
+        std::copy_backward(child_keys, child_keys + child_count, child_keys + child_count + 1);
+        if (leaf) {
+            child_keys[0] = left_keys[left_count - 1];
+            parent_keys[idx - 1] = child_keys[0];
+        } else {
+            std::copy_backward(child_children, child_children + child_count + 1, child_children + child_count + 2);
+            child_keys[0] = parent_keys[idx - 1];
+            child_children[0] = left_children[left_count];
+            parent_keys[idx - 1] = left_keys[left_count - 1];
+            left_children[left_count] = -1;
+        }
+        left_keys[left_count - 1] = std::numeric_limits<float>::infinity();
+        --left_count;
+        ++child_count;
+    } else if (right != -1 && tree.pool.count[right] > BPLUS_MIN_KEYS) {
+        // Borrow the first key of the right sibling.
+        float *right_keys = BPlusTree_keys(tree, right);
+        int *right_children = BPlusTree_children(tree, right);
+        if (leaf) {
+            child_keys[child_count] = right_keys[0];
+            BPlusTree_removeAt(tree, right, 0);
+            parent_keys[idx] = right_keys[0];
+        } else {
+            child_keys[child_count] = parent_keys[idx];
+            child_children[child_count + 1] = right_children[0];
+            parent_keys[idx] = right_keys[0];
+            // Drop the right sibling's first key and first child.
+            int &right_count = tree.pool.count[right];
+            std::copy(right_keys + 1, right_keys + right_count, right_keys);
+            right_keys[right_count - 1] = std::numeric_limits<float>::infinity();
+            std::copy(right_children + 1, right_children + right_count + 1, right_children);
+            right_children[right_count] = -1;
+            --right_count;
+        }
+        ++child_count;
+    } else {
+        // Merge with a sibling: always fold the right node of the pair into the left one.
+        int merge_idx = (right != -1) ? idx : idx - 1;
+        int dst = parent_children[merge_idx];
+        int src = parent_children[merge_idx + 1];
+        float *dst_keys = BPlusTree_keys(tree, dst);
+        int *dst_children = BPlusTree_children(tree, dst);
+        int &dst_count = tree.pool.count[dst];
+        if (leaf) {
+            std::copy_n(BPlusTree_keys(tree, src), tree.pool.count[src], dst_keys + dst_count);
+            dst_count += tree.pool.count[src];
+            tree.pool.next_leaf[dst] = tree.pool.next_leaf[src];
+        } else {
+            // The separator comes down between the two key runs.
+            dst_keys[dst_count] = parent_keys[merge_idx];
+            std::copy_n(BPlusTree_keys(tree, src), tree.pool.count[src], dst_keys + dst_count + 1);
+            std::copy_n(BPlusTree_children(tree, src), tree.pool.count[src] + 1, dst_children + dst_count + 1);
+            dst_count += tree.pool.count[src] + 1;
+        }
+        BPlusTree_removeAt(tree, parent, merge_idx);
+        BPlusTree_deallocateNode(tree, src);
+    }
+}
+
+// Delete key from the subtree rooted at node_idx.
+// Returns true if the key was found and removed.
+bool BPlusTree_deleteAt(BPlusTree &tree, int node_idx, const float &key) {
+    if (tree.pool.leaf[node_idx]) {
+        int pos = BPlusTree_rank(BPlusTree_keys(tree, node_idx), tree.pool.count[node_idx], key, false);
+        if (pos >= tree.pool.count[node_idx] || BPlusTree_keys(tree, node_idx)[pos] != key)
+            return false;
+        BPlusTree_removeAt(tree, node_idx, pos);
+        return true;
+    }
+    int idx = BPlusTree_rank(BPlusTree_keys(tree, node_idx), tree.pool.count[node_idx], key, true);
+    int child = BPlusTree_children(tree, node_idx)[idx];
+    if (!BPlusTree_deleteAt(tree, child, key))
+        return false;
+    if (tree.pool.count[child] < BPLUS_MIN_KEYS)
+        BPlusTree_fixChild(tree, node_idx, idx);
+    return true;
+}
+
+// Delete a key from the BPlusTree.
+void BPlusTree_delete(BPlusTree &tree, const float &key) {
+    if (std::isnan(key)) {
+        CONTAINER_ERROR(ContainerError::InvalidKey, "NaN cannot be used as a key.");
+        return;
+    }
+    if (tree.root == -1 || !BPlusTree_deleteAt(tree, tree.root, key)) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Key " << key << " not found.");
+        return;
+    }
+    // Shrink the tree when the root runs out of keys.
+    if (tree.pool.count[tree.root] == 0) {
+        int old_root = tree.root;
+        if (tree.pool.leaf[old_root]) {
+            tree.root = -1;
+            tree.first_leaf = -1;
+        } else {
+            tree.root = BPlusTree_children(tree, old_root)[0];
+        }
+        BPlusTree_deallocateNode(tree, old_root);
+    }
+}
+
+// Print the BPlusTree keys in order by walking the leaf chain.
+void BPlusTree_print(const BPlusTree &tree) {
+    std::cout << "BPlusTree: ";
+    for (int leaf = tree.first_leaf; leaf != -1; leaf = tree.pool.next_leaf[leaf]) {
+        const float *keys = BPlusTree_keys(tree, leaf);
+        for (int i = 0; i < tree.pool.count[leaf]; ++i)
+            std::cout << keys[i] << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Demonstration of BPlusTree operations.
+int main() {
+    constexpr size_t N = 4;
+    BPlusTree tree;
+
+    // Initialize the BPlusTree with a pool of N nodes; it grows as leaves split.
+    BPlusTree_init(tree, N);
+
+    // Insert keys 0, 7, 14, ... (mod 101) so the input is not sorted.
+    for (int i = 0; i < 101; ++i)
+        BPlusTree_insert(tree, static_cast<float>((i * 7) % 101));
+    BPlusTree_print(tree);  // Expected output: 0 1 2 ... 100
+
+    // Search for a key.
+    int result;
+    BPlusTree_search(tree, 42.0f, result);
+    if (result != -1)
+        std::cout << "Key 42 found in leaf node: " << result << std::endl;
+    else
+        std::cout << "Key 42 not found." << std::endl;
+
+    // Range scan.
+    std::cout << "Range [20, 30]: ";
+    BPlusTree_range(tree, 20.0f, 30.0f, [](float key) { std::cout << key << " "; });
+    std::cout << std::endl;  // Expected output: 20 21 ... 30
+
+    // Delete every even key.
+    for (int i = 0; i <= 100; i += 2)
+        BPlusTree_delete(tree, static_cast<float>(i));
+    BPlusTree_print(tree);  // Expected output: 1 3 5 ... 99
+
+    BPlusTree_search(tree, 42.0f, result);
+    std::cout << "Key 42 after deletion: " << result << std::endl;  // Expected: -1
+
+    // Infinities are ordinary keys; NaN has no place in the order and is rejected.
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    BPlusTree_insert(tree, inf);
+    BPlusTree_insert(tree, -inf);
+    BPlusTree_insert(tree, std::numeric_limits<float>::quiet_NaN());  // Error: NaN cannot be used as a key.
+    BPlusTree_search(tree, inf, result);
+    std::cout << "Key inf found: " << (result != -1) << std::endl;  // Expected: 1
+    std::cout << "Range [-inf, 3]: ";
+    BPlusTree_range(tree, -inf, 3.0f, [](float key) { std::cout << key << " "; });
+    std::cout << std::endl;  // Expected output: -inf 1 3
+    BPlusTree_delete(tree, inf);
+    BPlusTree_delete(tree, inf);  // Error: Key inf not found.
+
+    // A fixed-size pool refuses an insert that would need more nodes than
+    // are free, before any node splits, so no key is lost.
+    BPlusTree fixed;
+    BPlusTree_init(fixed, 1);
+    fixed.pool.growable = false;
+    for (int i = 0; i <= BPLUS_MAX_KEYS; ++i)
+        BPlusTree_insert(fixed, static_cast<float>(i));  // Error on the last key: No free node available.
+    BPlusTree_print(fixed);  // Expected output: 0 1 2 ... 31
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+// Kinds of recoverable container errors.
+enum class ContainerError : std::uint8_t {
+    Empty,        // Pop or peek on an empty container.
+    Full,         // No free slot, and the storage cannot grow.
+    OutOfRange,   // Node index or handle outside the pool.
+    NotAllocated, // Node index that is not in use (for example a double free).
+    NotFound,     // Key, value or handle not present.
+    Duplicate,    // Handle that is already present.
+    InvalidKey,   // Key that cannot be used: NaN, or a key change in the wrong direction.
+    Count         // Number of kinds.
+};
+
+// Error policies, selected at compile time with -DCONTAINER_ERROR_POLICY=<policy>.
+#define CONTAINER_ERROR_LOG 0    // Print each error to std::cerr (default).
+#define CONTAINER_ERROR_ASSERT 1 // assert() in debug builds; nothing at all under NDEBUG.
+#define CONTAINER_ERROR_COUNT 2  // Count errors per kind; no I/O on the operation path.
+
+#ifndef CONTAINER_ERROR_POLICY
+#define CONTAINER_ERROR_POLICY CONTAINER_ERROR_LOG
+#endif
+
+// Per-kind error counters, incremented under the CONTAINER_ERROR_COUNT policy.
+inline std::atomic<std::uint64_t> container_error_counts[static_cast<size_t>(ContainerError::Count)];
+
+// Number of errors of the given kind counted so far (CONTAINER_ERROR_COUNT policy).
+inline std::uint64_t ContainerError_count(const ContainerError kind) {
+    return container_error_counts[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+}
+
+// Report a container error of the given kind. message is a stream
+// expression starting with a string literal (for example
+// "Node " << idx << " is already deallocated.") and is only evaluated by
+// the log policy, which pastes the "Error: " prefix onto that literal.
+#if CONTAINER_ERROR_POLICY == CONTAINER_ERROR_LOG
+#define CONTAINER_ERROR(kind, message) (std::cerr << "Error: " message << '\n')
+#elif CONTAINER_ERROR_POLICY == CONTAINER_ERROR_ASSERT
+#define CONTAINER_ERROR(kind, message) assert(((void)(kind), !"container error"))
+#elif CONTAINER_ERROR_POLICY == CONTAINER_ERROR_COUNT
+#define CONTAINER_ERROR(kind, message) \
+    container_error_counts[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed)
+#else
+#error "Unknown CONTAINER_ERROR_POLICY"
+#endif
@@ -1,94 +1,155 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <expected>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
+#include "node_pool_compact.hpp"
 
 // Deque structure using a free-node pool for storage.
+template <typename T, typename Index = int>
 struct Deque {
-    int head{-1};  // Index of the first element.
-    int tail{-1};  // Index of the last element.
+    Index head{NULL_INDEX<Index>}; // Index of the first element.
+    Index tail{NULL_INDEX<Index>}; // Index of the last element.
     
-    // Free-node pool holding node arrays and free list information.
+    // Free-node pool holding node arrays and their occupancy allocator.
     struct {
-        std::unique_ptr<float[]> data{nullptr};     // Node values.
-        std::unique_ptr<int[]> next{nullptr};         // Next pointers (indices).
-        std::unique_ptr<int[]> prev{nullptr};         // Previous pointers (indices).
-        std::unique_ptr<int[]> next_free{nullptr};    // Free list linking.
-        std::unique_ptr<bool[]> allocated{nullptr};   // Allocation flags.
-        size_t size{0};                               // Total number of nodes.
-        int free_head{-1};                            // Head of the free list.
+        std::unique_ptr<T[]> data{nullptr};     // Node values.
+        std::unique_ptr<Index[]> next{nullptr}; // Next pointers (indices).
+        std::unique_ptr<Index[]> prev{nullptr}; // Previous pointers (indices).
+        NodePool<Index> slots;                  // Occupancy bitmap allocator.
+        bool growable{true};                    // Grow the pool when it runs out of free nodes.
     } pool;
 };
 
 // Initialize the Deque with N nodes.
-// All nodes are initially free and linked as a free list.
-void Deque_init(Deque &deque, const size_t N) {
-    deque.head = -1;
-    deque.tail = -1;
-    deque.pool.size = N;
-    deque.pool.data = std::make_unique<float[]>(N);
-    deque.pool.next = std::make_unique<int[]>(N);
-    deque.pool.prev = std::make_unique<int[]>(N);
-    deque.pool.next_free = std::make_unique<int[]>(N);
-    deque.pool.allocated = std::make_unique<bool[]>(N);
-    deque.pool.free_head = 0;  // Free list starts at index 0
+// All nodes are initially free.
+template <typename T, typename Index>
+void Deque_init(Deque<T, Index> &deque, const size_t N) {
+    deque.head = NULL_INDEX<Index>;
+    deque.tail = NULL_INDEX<Index>;
+    NodePool_init(deque.pool.slots, N);
+    deque.pool.data = make_payload_array<T>(N);
+    deque.pool.next = std::make_unique<Index[]>(N);
+    deque.pool.prev = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i) {
-        deque.pool.data[i] = 0.0f;
-        deque.pool.next[i] = -1;
-        deque.pool.prev[i] = -1;
-        deque.pool.allocated[i] = false;
-        deque.pool.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+        deque.pool.next[i] = NULL_INDEX<Index>;
+        deque.pool.prev[i] = NULL_INDEX<Index>;
+    }
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool Deque_growPool(Deque<T, Index> &deque) {
+    const size_t old_size = deque.pool.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(deque.pool.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+    auto prev = std::make_unique<Index[]>(new_size);
+
+    std::move(deque.pool.data.get(), deque.pool.data.get() + old_size, data.get());
+    std::copy_n(deque.pool.next.get(), old_size, next.get());
+    std::copy_n(deque.pool.prev.get(), old_size, prev.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        next[i] = NULL_INDEX<Index>;
+        prev[i] = NULL_INDEX<Index>;
     }
+
+    deque.pool.data = std::move(data);
+    deque.pool.next = std::move(next);
+    deque.pool.prev = std::move(prev);
+    return true;
+}
+
+// Shrink the pool to new_size nodes, releasing the node arrays above it.
+// Every node at or above new_size must be free; returns false otherwise.
+template <typename T, typename Index>
+bool Deque_shrinkPool(Deque<T, Index> &deque, const size_t new_size) {
+    if (!NodePool_shrink(deque.pool.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+    auto prev = std::make_unique<Index[]>(new_size);
+
+    std::move(deque.pool.data.get(), deque.pool.data.get() + new_size, data.get());
+    std::copy_n(deque.pool.next.get(), new_size, next.get());
+    std::copy_n(deque.pool.prev.get(), new_size, prev.get());
+
+    deque.pool.data = std::move(data);
+    deque.pool.next = std::move(next);
+    deque.pool.prev = std::move(prev);
+    return true;
 }
 
-// Allocate a node from the free list.
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
 // Initializes the node with the provided value and returns its index via node_idx.
-void Deque_allocateNode(Deque &deque, const float value, int &node_idx) {
-    node_idx = -1;
-    if (deque.pool.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void Deque_allocateNode(Deque<T, Index> &deque, const T &value, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(deque.pool.slots) &&
+        !(deque.pool.growable && Deque_growPool(deque))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // "Pop" a node from the free list.
-    node_idx = deque.pool.free_head;
-    deque.pool.free_head = deque.pool.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(deque.pool.slots, node_idx);
 
     // Initialize the node.
     deque.pool.data[node_idx] = value;
-    deque.pool.next[node_idx] = -1;
-    deque.pool.prev[node_idx] = -1;
-    deque.pool.allocated[node_idx] = true;
+    deque.pool.next[node_idx] = NULL_INDEX<Index>;
+    deque.pool.prev[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by pushing it back onto the free list.
+// Deallocate a node by returning it to the pool.
 // Checks for double deallocation.
-void Deque_deallocateNode(Deque &deque, const int idx) {
-    if (idx < 0 || static_cast<size_t>(idx) >= deque.pool.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+template <typename T, typename Index>
+void Deque_deallocateNode(Deque<T, Index> &deque, const Index idx) {
+    if (static_cast<size_t>(idx) >= deque.pool.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
-    if (!deque.pool.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(deque.pool.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     // Reset node's data and pointers.
-    deque.pool.data[idx] = 0.0f;
-    deque.pool.next[idx] = -1;
-    deque.pool.prev[idx] = -1;
-    deque.pool.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        deque.pool.data[idx] = T{}; // Release resources held by the payload.
+    deque.pool.next[idx] = NULL_INDEX<Index>;
+    deque.pool.prev[idx] = NULL_INDEX<Index>;
 
-    // "Push" this node back onto the free list.
-    deque.pool.next_free[idx] = deque.pool.free_head;
-    deque.pool.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(deque.pool.slots, idx);
 }
 
 // Insert a value at the front of the deque.
-void Deque_pushFront(Deque &deque, const float value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void Deque_pushFront(Deque<T, Index> &deque, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     Deque_allocateNode(deque, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
-    if (deque.head == -1) {
+    if (deque.head == NULL_INDEX<Index>) {
         // If the deque is empty, new node becomes both head and tail.
         deque.head = new_node;
         deque.tail = new_node;
@@ -101,13 +162,14 @@ void Deque_pushFront(Deque &deque, const float value) {
 }
 
 // Insert a value at the back of the deque.
-void Deque_pushBack(Deque &deque, const float value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void Deque_pushBack(Deque<T, Index> &deque, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     Deque_allocateNode(deque, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
-    if (deque.tail == -1) {
+    if (deque.tail == NULL_INDEX<Index>) {
         // If the deque is empty, new node becomes both head and tail.
         deque.head = new_node;
         deque.tail = new_node;
@@ -119,79 +181,434 @@ void Deque_pushBack(Deque &deque, const float value) {
     }
 }
 
-// Remove and return the value at the front of the deque.
-float Deque_popFront(Deque &deque) {
-    if (deque.head == -1) {
-        std::cerr << "Error: Deque is empty." << std::endl;
-        return 0.0f;
-    }
-    int node_idx = deque.head;
-    float value = deque.pool.data[node_idx];
+// Remove and return the value at the front of the deque without reporting an error.
+// Returns ContainerError::Empty if the deque is empty.
+template <typename T, typename Index>
+std::expected<T, ContainerError> Deque_tryPopFront(Deque<T, Index> &deque) {
+    if (deque.head == NULL_INDEX<Index>)
+        return std::unexpected(ContainerError::Empty);
+    Index node_idx = deque.head;
+    T value = std::move(deque.pool.data[node_idx]);
 
     // Update head to the next node.
     deque.head = deque.pool.next[node_idx];
-    if (deque.head != -1)
-        deque.pool.prev[deque.head] = -1;
+    if (deque.head != NULL_INDEX<Index>)
+        deque.pool.prev[deque.head] = NULL_INDEX<Index>;
     else
-        deque.tail = -1;  // Deque is now empty.
+        deque.tail = NULL_INDEX<Index>;  // Deque is now empty.
 
     Deque_deallocateNode(deque, node_idx);
     return value;
 }
 
-// Remove and return the value at the back of the deque.
-float Deque_popBack(Deque &deque) {
-    if (deque.tail == -1) {
-        std::cerr << "Error: Deque is empty." << std::endl;
-        return 0.0f;
+// Remove and return the value at the front of the deque.
+template <typename T, typename Index>
+T Deque_popFront(Deque<T, Index> &deque) {
+    auto value = Deque_tryPopFront(deque);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Deque is empty.");
+        return T{};
     }
-    int node_idx = deque.tail;
-    float value = deque.pool.data[node_idx];
+    return std::move(*value);
+}
+
+// Remove and return the value at the back of the deque without reporting an error.
+// Returns ContainerError::Empty if the deque is empty.
+template <typename T, typename Index>
+std::expected<T, ContainerError> Deque_tryPopBack(Deque<T, Index> &deque) {
+    if (deque.tail == NULL_INDEX<Index>)
+        return std::unexpected(ContainerError::Empty);
+    Index node_idx = deque.tail;
+    T value = std::move(deque.pool.data[node_idx]);
 
     // Update tail to the previous node.
     deque.tail = deque.pool.prev[node_idx];
-    if (deque.tail != -1)
-        deque.pool.next[deque.tail] = -1;
+    if (deque.tail != NULL_INDEX<Index>)
+        deque.pool.next[deque.tail] = NULL_INDEX<Index>;
     else
-        deque.head = -1;  // Deque is now empty.
+        deque.head = NULL_INDEX<Index>;  // Deque is now empty.
 
     Deque_deallocateNode(deque, node_idx);
     return value;
 }
 
+// Remove and return the value at the back of the deque.
+template <typename T, typename Index>
+T Deque_popBack(Deque<T, Index> &deque) {
+    auto value = Deque_tryPopBack(deque);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Deque is empty.");
+        return T{};
+    }
+    return std::move(*value);
+}
+
 // Peek at the front value of the deque without removing it.
-float Deque_peekFront(const Deque &deque) {
-    if (deque.head == -1) {
-        std::cerr << "Error: Deque is empty." << std::endl;
-        return 0.0f;
+template <typename T, typename Index>
+T Deque_peekFront(const Deque<T, Index> &deque) {
+    if (deque.head == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::Empty, "Deque is empty.");
+        return T{};
     }
     return deque.pool.data[deque.head];
 }
 
 // Peek at the back value of the deque without removing it.
-float Deque_peekBack(const Deque &deque) {
-    if (deque.tail == -1) {
-        std::cerr << "Error: Deque is empty." << std::endl;
-        return 0.0f;
+template <typename T, typename Index>
+T Deque_peekBack(const Deque<T, Index> &deque) {
+    if (deque.tail == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::Empty, "Deque is empty.");
+        return T{};
     }
     return deque.pool.data[deque.tail];
 }
 
+// Run one slice of an incremental compaction, handling at most budget nodes.
+// Renumbers the live nodes so that traversal from the head is one
+// sequential sweep through memory, and leaves the free nodes as one
+// contiguous tail. Other operations may run between slices. Start with a
+// default-constructed state; returns true once the pass is complete.
+template <typename T, typename Index>
+bool Deque_compactStep(Deque<T, Index> &deque, NodePoolCompaction<Index> &state, const size_t budget) {
+    auto make_links = [&deque] {
+        return NodePoolLinks<T, Index>{deque.pool.data.get(), deque.pool.next.get(), deque.pool.prev.get(),
+                                       &deque.head, &deque.tail, false};
+    };
+    auto grow = [&deque] { return deque.pool.growable && Deque_growPool(deque); };
+    auto shrink = [&deque](const size_t new_size) { Deque_shrinkPool(deque, new_size); };
+    return NodePool_compactStep(deque.pool.slots, state, budget, make_links, grow, shrink);
+}
+
+// Compact the deque in a single pass.
+template <typename T, typename Index>
+void Deque_compact(Deque<T, Index> &deque) {
+    NodePoolCompaction<Index> state;
+    Deque_compactStep(deque, state, std::numeric_limits<size_t>::max());
+}
+
+// Fraction of links that do not lead to the adjacent node slot (0: fully sequential).
+template <typename T, typename Index>
+double Deque_fragmentation(const Deque<T, Index> &deque) {
+    return NodePool_fragmentation(deque.pool.next.get(), deque.head, false);
+}
+
 // Print the contents of the deque (from front to back).
-void Deque_print(const Deque &deque) {
-    int current = deque.head;
+template <typename T, typename Index>
+void Deque_print(const Deque<T, Index> &deque) {
+    Index current = deque.head;
     std::cout << "Deque: ";
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         std::cout << deque.pool.data[current] << " ";
         current = deque.pool.next[current];
     }
     std::cout << std::endl;
 }
 
+// Deque stored as a growable circular buffer. Values sit contiguously in
+// one array, so there are no links to maintain, and the i-th value is at
+// (head + i) & mask.
+template <typename T>
+struct RingDeque {
+    size_t head{0}; // Position of the first value.
+    size_t size{0}; // Number of values.
+
+    // Circular buffer whose capacity is a power of two.
+    struct {
+        std::unique_ptr<T[]> data{nullptr}; // Slot values.
+        size_t mask{0};                     // Capacity - 1.
+        bool growable{true};                // Double the capacity when the buffer is full.
+    } ring;
+};
+
+// Initialize the ring deque with room for at least `capacity` values.
+// The capacity is rounded up to the next power of two.
+template <typename T>
+void RingDeque_init(RingDeque<T> &deque, const size_t capacity) {
+    const size_t size = std::bit_ceil(std::max<size_t>(capacity, 1));
+    deque.ring.data = make_payload_array<T>(size);
+    deque.ring.mask = size - 1;
+    deque.head = 0;
+    deque.size = 0;
+}
+
+// Double the capacity. Values are moved to the start of the new buffer in
+// deque order, so the wrap-around is undone.
+// Returns false if the capacity cannot grow any further.
+template <typename T>
+bool RingDeque_grow(RingDeque<T> &deque) {
+    const size_t old_size = deque.ring.mask + 1;
+    if (old_size > std::numeric_limits<size_t>::max() / 2)
+        return false;
+    const size_t new_size = 2 * old_size;
+    auto data = make_payload_array<T>(new_size);
+
+    // Move the part up to the end of the old buffer, then the wrapped part.
+    const size_t first = std::min(deque.size, old_size - deque.head);
+    std::move(deque.ring.data.get() + deque.head, deque.ring.data.get() + deque.head + first, data.get());
+    std::move(deque.ring.data.get(), deque.ring.data.get() + (deque.size - first), data.get() + first);
+
+    deque.ring.data = std::move(data);
+    deque.ring.mask = new_size - 1;
+    deque.head = 0;
+    return true;
+}
+
+// Make room for one more value, growing the buffer if it is full.
+// Returns false, after reporting the error, if there is no room.
+template <typename T>
+bool RingDeque_reserveOne(RingDeque<T> &deque) {
+    if (deque.size <= deque.ring.mask)
+        return true;
+    if (deque.ring.growable && RingDeque_grow(deque))
+        return true;
+    CONTAINER_ERROR(ContainerError::Full, "Ring deque is full.");
+    return false;
+}
+
+// Insert a value at the front of the ring deque.
+template <typename T>
+void RingDeque_pushFront(RingDeque<T> &deque, const T &value) {
+    if (!RingDeque_reserveOne(deque))
+        return;
+    deque.head = (deque.head - 1) & deque.ring.mask;
+    deque.ring.data[deque.head] = value;
+    ++deque.size;
+}
+
+// Insert a value at the back of the ring deque.
+template <typename T>
+void RingDeque_pushBack(RingDeque<T> &deque, const T &value) {
+    if (!RingDeque_reserveOne(deque))
+        return;
+    deque.ring.data[(deque.head + deque.size) & deque.ring.mask] = value;
+    ++deque.size;
+}
+
+// Remove and return the value at the front without reporting an error.
+// Returns ContainerError::Empty if the ring deque is empty.
+template <typename T>
+std::expected<T, ContainerError> RingDeque_tryPopFront(RingDeque<T> &deque) {
+    if (deque.size == 0)
+        return std::unexpected(ContainerError::Empty);
+    T value = std::move(deque.ring.data[deque.head]);
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        deque.ring.data[deque.head] = T{}; // Release resources held by the payload.
+    deque.head = (deque.head + 1) & deque.ring.mask;
+    --deque.size;
+    return value;
+}
+
+// Remove and return the value at the front of the ring deque.
+template <typename T>
+T RingDeque_popFront(RingDeque<T> &deque) {
+    auto value = RingDeque_tryPopFront(deque);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Ring deque is empty.");
+        return T{};
+    }
+    return std::move(*value);
+}
+
+// Remove and return the value at the back without reporting an error.
+// Returns ContainerError::Empty if the ring deque is empty.
+template <typename T>
+std::expected<T, ContainerError> RingDeque_tryPopBack(RingDeque<T> &deque) {
+    if (deque.size == 0)
+        return std::unexpected(ContainerError::Empty);
+    const size_t slot = (deque.head + deque.size - 1) & deque.ring.mask;
+    T value = std::move(deque.ring.data[slot]);
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        deque.ring.data[slot] = T{}; // Release resources held by the payload.
+    --deque.size;
+    return value;
+}
+
+// Remove and return the value at the back of the ring deque.
+template <typename T>
+T RingDeque_popBack(RingDeque<T> &deque) {
+    auto value = RingDeque_tryPopBack(deque);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Ring deque is empty.");
+        return T{};
+    }
+    return std::move(*value);
+}
+
+// Return the i-th value from the front in O(1).
+template <typename T>
+T RingDeque_at(const RingDeque<T> &deque, const size_t i) {
+    if (i >= deque.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Position " << i << " is out of range (size " << deque.size << ").");
+        return T{};
+    }
+    return deque.ring.data[(deque.head + i) & deque.ring.mask];
+}
+
+// Peek at the front value of the ring deque without removing it.
+template <typename T>
+T RingDeque_peekFront(const RingDeque<T> &deque) {
+    if (deque.size == 0) {
+        CONTAINER_ERROR(ContainerError::Empty, "Ring deque is empty.");
+        return T{};
+    }
+    return deque.ring.data[deque.head];
+}
+
+// Peek at the back value of the ring deque without removing it.
+template <typename T>
+T RingDeque_peekBack(const RingDeque<T> &deque) {
+    if (deque.size == 0) {
+        CONTAINER_ERROR(ContainerError::Empty, "Ring deque is empty.");
+        return T{};
+    }
+    return deque.ring.data[(deque.head + deque.size - 1) & deque.ring.mask];
+}
+
+// Print the contents of the ring deque (from front to back).
+template <typename T>
+void RingDeque_print(const RingDeque<T> &deque) {
+    std::cout << "RingDeque: ";
+    for (size_t i = 0; i < deque.size; ++i)
+        std::cout << deque.ring.data[(deque.head + i) & deque.ring.mask] << " ";
+    std::cout << std::endl;
+}
+
+// Cache line size used to keep concurrently written counters apart.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Chase-Lev work-stealing deque (in the C++11 memory-model formulation of
+// Le, Pop, Cohen and Zappa Nardelli). One owner thread pushes and pops at
+// the bottom, like Deque_pushBack and Deque_popBack; any number of thieves
+// take from the top, like Deque_popFront. The owner only synchronizes with
+// thieves when one value is left, and thieves race each other with a CAS
+// on top. Values are held in a growable circular array of atomic slots, so
+// T must be trivially copyable (typically a task pointer or handle).
+// When the owner grows the array, the old one is retired rather than
+// freed, since a thief may still be reading from it; retired arrays are
+// released with the deque.
+template <typename T>
+struct WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque values must be trivially copyable.");
+
+    // A circular array whose capacity is a power of two.
+    struct Ring {
+        std::unique_ptr<std::atomic<T>[]> slots{nullptr}; // Slot values.
+        size_t mask{0};                                   // Capacity - 1.
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top{0};    // Next position to steal (thieves).
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom{0}; // Next position to push (owner).
+    alignas(CACHE_LINE_SIZE) std::atomic<Ring *> ring{nullptr};   // Current circular array.
+    std::vector<std::unique_ptr<Ring>> rings;                     // Current and retired arrays (owner only).
+};
+
+// Initialize the work-stealing deque with room for at least `capacity` values.
+// The capacity is rounded up to the next power of two.
+// Must not race with any other operation.
+template <typename T>
+void WorkStealingDeque_init(WorkStealingDeque<T> &deque, const size_t capacity) {
+    const size_t size = std::bit_ceil(std::max<size_t>(capacity, 1));
+    auto ring = std::make_unique<typename WorkStealingDeque<T>::Ring>();
+    ring->slots = std::make_unique<std::atomic<T>[]>(size);
+    ring->mask = size - 1;
+    deque.rings.clear();
+    deque.ring.store(ring.get(), std::memory_order_relaxed);
+    deque.rings.push_back(std::move(ring));
+    deque.top.store(0, std::memory_order_relaxed);
+    deque.bottom.store(0, std::memory_order_relaxed);
+}
+
+// Replace the full ring with one of twice the capacity holding the values
+// at positions [top, bottom) (owner only). Returns the new ring.
+template <typename T>
+typename WorkStealingDeque<T>::Ring *WorkStealingDeque_grow(WorkStealingDeque<T> &deque,
+                                                           const typename WorkStealingDeque<T>::Ring *old,
+                                                           const std::int64_t top, const std::int64_t bottom) {
+    auto ring = std::make_unique<typename WorkStealingDeque<T>::Ring>();
+    const size_t size = 2 * (old->mask + 1);
+    ring->slots = std::make_unique<std::atomic<T>[]>(size);
+    ring->mask = size - 1;
+    for (std::int64_t i = top; i < bottom; ++i) {
+        const T value = old->slots[static_cast<size_t>(i) & old->mask].load(std::memory_order_relaxed);
+        ring->slots[static_cast<size_t>(i) & ring->mask].store(value, std::memory_order_relaxed);
+    }
+    // Publish the copied slots before thieves can load the new ring.
+    deque.ring.store(ring.get(), std::memory_order_release);
+    deque.rings.push_back(std::move(ring));
+    return deque.rings.back().get();
+}
+
+// Push a value at the bottom (owner only). Grows the ring when it is full.
+template <typename T>
+void WorkStealingDeque_push(WorkStealingDeque<T> &deque, const T &value) {
+    const std::int64_t bottom = deque.bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = deque.top.load(std::memory_order_acquire);
+    auto *ring = deque.ring.load(std::memory_order_relaxed);
+    if (static_cast<size_t>(bottom - top) > ring->mask)
+        ring = WorkStealingDeque_grow(deque, ring, top, bottom);
+    ring->slots[static_cast<size_t>(bottom) & ring->mask].store(value, std::memory_order_relaxed);
+    // Publish the value before the new bottom becomes visible to thieves.
+    std::atomic_thread_fence(std::memory_order_release);
+    deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+// Pop the most recently pushed value into value (owner only).
+// Returns false if the deque is empty, or if a thief took the last value.
+template <typename T>
+bool WorkStealingDeque_pop(WorkStealingDeque<T> &deque, T &value) {
+    const std::int64_t bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+    auto *ring = deque.ring.load(std::memory_order_relaxed);
+    deque.bottom.store(bottom, std::memory_order_relaxed);
+    // Order the claim on bottom before reading top; pairs with the fence in steal.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = deque.top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // Empty: undo the claim.
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    value = ring->slots[static_cast<size_t>(bottom) & ring->mask].load(std::memory_order_relaxed);
+    if (top < bottom)
+        return true; // More than one value was left: no thief can reach this one.
+
+    // Last value: race the thieves for it.
+    const bool won =
+        deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+// Steal the oldest value into value. Safe to call from any thread.
+// Returns false if the deque is empty or another thread took the value
+// first; the caller may retry or pick another victim.
+template <typename T>
+bool WorkStealingDeque_steal(WorkStealingDeque<T> &deque, T &value) {
+    std::int64_t top = deque.top.load(std::memory_order_acquire);
+    // Read top before bottom; pairs with the fence in pop.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = deque.bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return false;
+
+    const auto *ring = deque.ring.load(std::memory_order_acquire);
+    value = ring->slots[static_cast<size_t>(top) & ring->mask].load(std::memory_order_relaxed);
+    // Claim the value; fails if the owner or another thief took it first.
+    return deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+// Approximate number of values in the deque. Safe to call from any thread.
+template <typename T>
+size_t WorkStealingDeque_size(const WorkStealingDeque<T> &deque) {
+    const std::int64_t bottom = deque.bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = deque.top.load(std::memory_order_relaxed);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
 // Demonstration of deque operations.
 int main() {
     constexpr size_t N = 10;
-    Deque deque;
+    Deque<float> deque;
     
     // Initialize the deque with N nodes.
     Deque_init(deque, N);
@@ -215,5 +632,87 @@ int main() {
     std::cout << "Popped from back: " << Deque_popBack(deque) << std::endl;
     Deque_print(deque);  // Expected: 1.1 2.2
     
+    // Push past the initial capacity at both ends; the pool grows on demand.
+    for (int i = 0; i < static_cast<int>(N); ++i) {
+        Deque_pushFront(deque, static_cast<float>(-i));
+        Deque_pushBack(deque, static_cast<float>(10 + i));
+    }
+    std::cout << "Pool size after growth: " << deque.pool.slots.size << std::endl;
+    Deque_print(deque);  // Expected: -9 ... -1 0 1.1 2.2 10 ... 19
+    
+    // Pushes at the front link backwards through the pool; compaction swaps
+    // the nodes into front-to-back order in place.
+    std::cout << "Fragmentation before compaction: " << Deque_fragmentation(deque) << std::endl;
+    Deque_compact(deque);
+    std::cout << "Fragmentation after compaction: " << Deque_fragmentation(deque) << std::endl;  // Expected: 0
+    Deque_print(deque);  // Expected: -9 ... -1 0 1.1 2.2 10 ... 19
+    
+    // Payload and index types are template parameters: strings linked
+    // with 8-bit indices, so each link costs one byte.
+    Deque<std::string, std::uint8_t> words;
+    Deque_init(words, 4);
+    Deque_pushBack(words, std::string("middle"));
+    Deque_pushFront(words, std::string("first"));
+    Deque_pushBack(words, std::string("last"));
+    Deque_print(words);  // Expected: first middle last
+    
+    // The ring deque keeps the values contiguous and indexes them in O(1).
+    RingDeque<float> ring;
+    RingDeque_init(ring, 4);
+    for (int i = 1; i <= 3; ++i) {
+        RingDeque_pushFront(ring, static_cast<float>(-i));
+        RingDeque_pushBack(ring, static_cast<float>(i));
+    }
+    RingDeque_print(ring);  // Expected: -3 -2 -1 1 2 3
+    std::cout << "Capacity: " << ring.ring.mask + 1 << ", at(2): " << RingDeque_at(ring, 2) << std::endl;  // Expected: 8, -1
+    std::cout << "Popped from front: " << RingDeque_popFront(ring)
+              << ", from back: " << RingDeque_popBack(ring) << std::endl;  // Expected: -3, 3
+    RingDeque_print(ring);  // Expected: -2 -1 1 2
+    
+    // Work stealing: each worker owns a deque of ranges to sum. A worker
+    // splits its range, pushes the upper half and keeps the lower half;
+    // idle workers steal the oldest, largest ranges from the others.
+    struct Range {
+        std::uint32_t begin;
+        std::uint32_t end;
+    };
+    constexpr std::uint32_t TOTAL = 1 << 20;
+    constexpr std::uint32_t GRAIN = 1024;
+    const unsigned workers_count = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<WorkStealingDeque<Range>> tasks(workers_count);
+    for (WorkStealingDeque<Range> &queue : tasks)
+        WorkStealingDeque_init(queue, 16);
+    WorkStealingDeque_push(tasks[0], Range{0, TOTAL});
+    std::atomic<std::uint32_t> summed{0};
+    std::atomic<long long> total_sum{0};
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < workers_count; ++w) {
+        workers.emplace_back([&, w] {
+            long long local_sum = 0;
+            unsigned attempts = 0;
+            Range range;
+            while (summed.load(std::memory_order_acquire) < TOTAL) {
+                // Fall back to stealing from the other workers in turn.
+                const unsigned victim = (w + 1 + attempts++ % (workers_count - 1)) % workers_count;
+                if (!WorkStealingDeque_pop(tasks[w], range) && !WorkStealingDeque_steal(tasks[victim], range)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                while (range.end - range.begin > GRAIN) {
+                    const std::uint32_t middle = range.begin + (range.end - range.begin) / 2;
+                    WorkStealingDeque_push(tasks[w], Range{middle, range.end});
+                    range.end = middle;
+                }
+                for (std::uint32_t i = range.begin; i < range.end; ++i)
+                    local_sum += i;
+                summed.fetch_add(range.end - range.begin, std::memory_order_release);
+            }
+            total_sum.fetch_add(local_sum, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    std::cout << "Work-stealing sum: " << total_sum.load() << std::endl;  // Expected: 549755289600
+    
     return 0;
 }
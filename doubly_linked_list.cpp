@@ -1,38 +1,47 @@
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 
 // Node structure for the doubly linked list.
+template <typename T>
 struct Node {
-    int data {0};
-    std::unique_ptr<Node> next {nullptr}; // Unique ownership of the next node.
-    Node* prev {nullptr};                 // Raw pointer to the previous node.
+    T data {};
+    std::unique_ptr<Node<T>> next {nullptr}; // Unique ownership of the next node.
+    Node<T>* prev {nullptr};                 // Raw pointer to the previous node.
 };
 
 // Helper function: returns the raw pointer from a unique_ptr.
-Node* ptr(std::unique_ptr<Node>& up) {
+template <typename T>
+Node<T>* ptr(std::unique_ptr<Node<T>>& up) {
     return up.get();
 }
 
 // Overload for const unique_ptr.
-const Node* ptr(const std::unique_ptr<Node>& up) {
+template <typename T>
+const Node<T>* ptr(const std::unique_ptr<Node<T>>& up) {
     return up.get();
 }
 
 // Create a new node with the given value.
-std::unique_ptr<Node> create_node(int value) {
-    auto node = std::make_unique<Node>();
+template <typename T>
+std::unique_ptr<Node<T>> create_node(const T& value) {
+    auto node = std::make_unique<Node<T>>();
     node->data = value;
     return node;
 }
 
 // Append: Insert a new node with 'value' at the end of the list.
-void append(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+void append(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     if (!head) {
         head = create_node(value);
         return;
     }
     
-    Node* current = ptr(head);
+    Node<T>* current = ptr(head);
     while (current->next) {
         current = ptr(current->next);
     }
@@ -43,7 +52,8 @@ void append(std::unique_ptr<Node>& head, int value) {
 }
 
 // Prepend: Insert a new node with 'value' at the beginning of the list.
-void prepend(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+void prepend(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     auto newNode = create_node(value);
     if (head) {
         head->prev = newNode.get();
@@ -53,11 +63,12 @@ void prepend(std::unique_ptr<Node>& head, int value) {
 }
 
 // Search: Return a raw pointer to the first node with the given value, or nullptr if not found.
-Node* search(const std::unique_ptr<Node>& head, int value) {
-    const Node* current = ptr(head);
+template <typename T>
+Node<T>* search(const std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
+    const Node<T>* current = ptr(head);
     while (current) {
         if (current->data == value)
-            return const_cast<Node*>(current); // Return non-const pointer.
+            return const_cast<Node<T>*>(current); // Return non-const pointer.
         current = ptr(current->next);
     }
     return nullptr;
@@ -65,11 +76,12 @@ Node* search(const std::unique_ptr<Node>& head, int value) {
 
 // Remove: Delete the first node whose data equals 'value'.
 // Returns true if a node was removed, false otherwise.
-bool remove(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+bool remove(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     if (!head)
         return false;
     
-    Node* current = ptr(head);
+    Node<T>* current = ptr(head);
     while (current) {
         if (current->data == value) {
             // If the node to be removed is the head.
@@ -79,7 +91,7 @@ bool remove(std::unique_ptr<Node>& head, int value) {
                     head->prev = nullptr;
             } else {
                 // Bypass the current node.
-                Node* prevNode = current->prev;
+                Node<T>* prevNode = current->prev;
                 prevNode->next = std::move(current->next);
                 if (prevNode->next)
                     prevNode->next->prev = prevNode;
@@ -92,9 +104,10 @@ bool remove(std::unique_ptr<Node>& head, int value) {
 }
 
 // Count: Return the number of nodes in the list.
-int count(const std::unique_ptr<Node>& head) {
+template <typename T>
+int count(const std::unique_ptr<Node<T>>& head) {
     int cnt = 0;
-    const Node* current = ptr(head);
+    const Node<T>* current = ptr(head);
     while (current) {
         ++cnt;
         current = ptr(current->next);
@@ -103,8 +116,9 @@ int count(const std::unique_ptr<Node>& head) {
 }
 
 // Reverse: Reverse the linked list in-place.
-void reverse(std::unique_ptr<Node>& head) {
-    std::unique_ptr<Node> newHead = nullptr;
+template <typename T>
+void reverse(std::unique_ptr<Node<T>>& head) {
+    std::unique_ptr<Node<T>> newHead = nullptr;
     while (head) {
         // Detach the head node.
         auto node = std::move(head);
@@ -124,8 +138,9 @@ void reverse(std::unique_ptr<Node>& head) {
 }
 
 // Traverse: Print the list's elements.
-void traverse(const std::unique_ptr<Node>& head) {
-    const Node* current = ptr(head);
+template <typename T>
+void traverse(const std::unique_ptr<Node<T>>& head) {
+    const Node<T>* current = ptr(head);
     while (current) {
         std::cout << current->data << " <-> ";
         current = ptr(current->next);
@@ -134,15 +149,302 @@ void traverse(const std::unique_ptr<Node>& head) {
 }
 
 // Cleanup: Iteratively clean up the list to prevent recursive destruction.
-void cleanup(std::unique_ptr<Node>& head) {
+template <typename T>
+void cleanup(std::unique_ptr<Node<T>>& head) {
     while (head) {
         // Move to the next node, releasing the current node.
         head = std::move(head->next);
     }
 }
 
+// List handle: owns the chain through head and caches its tail and size,
+// so push_back, size and splice are O(1).
+template <typename T>
+struct List {
+    std::unique_ptr<Node<T>> head {nullptr}; // First node.
+    Node<T>* tail {nullptr};                 // Last node.
+    size_t size {0};                         // Number of nodes.
+
+    List() = default;
+    List(List&& other) noexcept
+        : head(std::move(other.head)),
+          tail(std::exchange(other.tail, nullptr)),
+          size(std::exchange(other.size, 0)) {}
+    // Free the old chain before taking over the other list's.
+    List& operator=(List&& other) noexcept {
+        if (this != &other) {
+            cleanup(head);
+            head = std::move(other.head);
+            tail = std::exchange(other.tail, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+    // The handle owns its chain, so it is move-only.
+    List(const List&) = delete;
+    List& operator=(const List&) = delete;
+    // Destroy the nodes iteratively; the default recursive unique_ptr
+    // destruction would overflow the stack on long lists.
+    ~List() {
+        cleanup(head);
+    }
+};
+
+// Push_back: Insert a new node with 'value' at the end of the list in O(1).
+template <typename T>
+void push_back(List<T>& list, const std::type_identity_t<T>& value) {
+    auto newNode = create_node<T>(value);
+    Node<T>* raw = ptr(newNode);
+    newNode->prev = list.tail;  // Set the backward pointer.
+    if (list.tail)
+        list.tail->next = std::move(newNode);
+    else
+        list.head = std::move(newNode);
+    list.tail = raw;
+    ++list.size;
+}
+
+// Push_front: Insert a new node with 'value' at the beginning of the list.
+template <typename T>
+void push_front(List<T>& list, const std::type_identity_t<T>& value) {
+    prepend(list.head, value);
+    if (!list.tail)
+        list.tail = ptr(list.head);
+    ++list.size;
+}
+
+// Size: Return the number of nodes in the list in O(1).
+template <typename T>
+size_t size(const List<T>& list) {
+    return list.size;
+}
+
+// Splice: Move every node of 'other' to the end of 'list' in O(1), leaving 'other' empty.
+template <typename T>
+void splice(List<T>& list, List<T>& other) {
+    if (&list == &other || !other.head)
+        return;
+    other.head->prev = list.tail;
+    if (list.tail)
+        list.tail->next = std::move(other.head);
+    else
+        list.head = std::move(other.head);
+    list.tail = other.tail;
+    list.size += other.size;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+// Erase: Unlink and delete the given node of the list in O(1).
+template <typename T>
+void erase(List<T>& list, Node<T>* node) {
+    Node<T>* prevNode = node->prev;
+    if (node == list.tail)
+        list.tail = prevNode;
+    // Bypass the node; the owning pointer releases it.
+    std::unique_ptr<Node<T>>& owner = prevNode ? prevNode->next : list.head;
+    owner = std::move(node->next);
+    if (owner)
+        owner->prev = prevNode;
+    --list.size;
+}
+
+// Append: Adapter for push_back.
+template <typename T>
+void append(List<T>& list, const std::type_identity_t<T>& value) {
+    push_back(list, value);
+}
+
+// Prepend: Adapter for push_front.
+template <typename T>
+void prepend(List<T>& list, const std::type_identity_t<T>& value) {
+    push_front(list, value);
+}
+
+// Search: Return a raw pointer to the first node with the given value, or nullptr if not found.
+template <typename T>
+Node<T>* search(const List<T>& list, const std::type_identity_t<T>& value) {
+    return search(list.head, value);
+}
+
+// Remove: Delete the first node whose data equals 'value', keeping tail and size current.
+// Returns true if a node was removed, false otherwise.
+template <typename T>
+bool remove(List<T>& list, const std::type_identity_t<T>& value) {
+    Node<T>* node = search(list.head, value);
+    if (!node)
+        return false;
+    erase(list, node);
+    return true;
+}
+
+// Count: Adapter for size.
+template <typename T>
+int count(const List<T>& list) {
+    return static_cast<int>(list.size);
+}
+
+// Reverse: Reverse the list in-place; the old head becomes the tail.
+template <typename T>
+void reverse(List<T>& list) {
+    list.tail = ptr(list.head);
+    reverse(list.head);
+}
+
+// Traverse: Print the list's elements.
+template <typename T>
+void traverse(const List<T>& list) {
+    traverse(list.head);
+}
+
+// Cleanup: Free every node and reset the handle.
+template <typename T>
+void cleanup(List<T>& list) {
+    cleanup(list.head);
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+// Node of an arena-backed doubly linked list. The memory resource owns the node, so both links are raw pointers.
+template <typename T>
+struct ArenaNode {
+    T data {};
+    ArenaNode<T>* next {nullptr};
+    ArenaNode<T>* prev {nullptr};
+};
+
+// Doubly linked list whose nodes come from a std::pmr memory resource.
+// Backed by a std::pmr::monotonic_buffer_resource, creating a node is a
+// pointer bump into contiguous blocks, and release() tears the whole list
+// down at once. Memory of removed nodes is reclaimed only when the
+// resource is released; use a std::pmr::unsynchronized_pool_resource for
+// long-lived lists with heavy removal. Create one with
+// ArenaList<T> list{.alloc = &resource}.
+template <typename T>
+struct ArenaList {
+    ArenaNode<T>* head {nullptr};             // First node.
+    ArenaNode<T>* tail {nullptr};             // Last node, so append is O(1).
+    size_t size {0};                          // Number of nodes.
+    std::pmr::polymorphic_allocator<> alloc;  // Source of node memory.
+};
+
+// Create a new node with the given value in the list's memory resource.
+template <typename T>
+ArenaNode<T>* create_node(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = list.alloc.template new_object<ArenaNode<T>>();
+    node->data = value;
+    return node;
+}
+
+// Append: Insert a new node with 'value' at the end of the list.
+template <typename T>
+void append(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = create_node(list, value);
+    node->prev = list.tail;
+    if (list.tail)
+        list.tail->next = node;
+    else
+        list.head = node;
+    list.tail = node;
+    ++list.size;
+}
+
+// Prepend: Insert a new node with 'value' at the beginning of the list.
+template <typename T>
+void prepend(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = create_node(list, value);
+    node->next = list.head;
+    if (list.head)
+        list.head->prev = node;
+    else
+        list.tail = node;
+    list.head = node;
+    ++list.size;
+}
+
+// Search: Return a pointer to the first node with the given value, or nullptr if not found.
+template <typename T>
+ArenaNode<T>* search(const ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    for (ArenaNode<T>* current = list.head; current; current = current->next)
+        if (current->data == value)
+            return current;
+    return nullptr;
+}
+
+// Erase: Unlink and delete the given node of the list in O(1).
+template <typename T>
+void erase(ArenaList<T>& list, ArenaNode<T>* node) {
+    (node->prev ? node->prev->next : list.head) = node->next;
+    (node->next ? node->next->prev : list.tail) = node->prev;
+    list.alloc.delete_object(node);
+    --list.size;
+}
+
+// Remove: Delete the first node whose data equals 'value'.
+// Returns true if a node was removed, false otherwise.
+template <typename T>
+bool remove(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = search(list, value);
+    if (!node)
+        return false;
+    erase(list, node);
+    return true;
+}
+
+// Count: Return the number of nodes in the list, in O(1).
+template <typename T>
+int count(const ArenaList<T>& list) {
+    return static_cast<int>(list.size);
+}
+
+// Reverse: Reverse the linked list in-place by swapping each node's links.
+template <typename T>
+void reverse(ArenaList<T>& list) {
+    for (ArenaNode<T>* current = list.head; current; current = current->prev)
+        std::swap(current->next, current->prev);
+    std::swap(list.head, list.tail);
+}
+
+// Traverse: Print the list's elements.
+template <typename T>
+void traverse(const ArenaList<T>& list) {
+    for (const ArenaNode<T>* current = list.head; current; current = current->next)
+        std::cout << current->data << " <-> ";
+    std::cout << "null\n";
+}
+
+// Cleanup: Destroy and deallocate the nodes one by one. Works with any memory resource.
+template <typename T>
+void cleanup(ArenaList<T>& list) {
+    while (list.head) {
+        ArenaNode<T>* next = list.head->next;
+        list.alloc.delete_object(list.head);
+        list.head = next;
+    }
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+// Release: Tear the list down by releasing its monotonic arena, which must
+// back no other live objects. Node destructors only run when T needs them,
+// so for trivially destructible T this is O(1) in the list length.
+template <typename T>
+void release(ArenaList<T>& list, std::pmr::monotonic_buffer_resource& arena) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (ArenaNode<T>* current = list.head; current;) {
+            ArenaNode<T>* next = current->next;
+            std::destroy_at(current);
+            current = next;
+        }
+    }
+    arena.release();
+    list.head = nullptr;
+    list.tail = nullptr;
+    list.size = 0;
+}
+
 int main() {
-    std::unique_ptr<Node> head = nullptr;
+    std::unique_ptr<Node<int>> head = nullptr;
     
     // Append nodes with values 1 through 5.
     for (int i = 1; i <= 5; ++i) {
@@ -160,7 +462,7 @@ int main() {
     std::cout << "Count: " << count(head) << "\n\n";
     
     // Search for a node with value 3.
-    Node* found = search(head, 3);
+    Node<int>* found = search(head, 3);
     if (found)
         std::cout << "Found node with value: " << found->data << "\n\n";
     else
@@ -182,5 +484,41 @@ int main() {
     std::cout << "\nAfter cleanup, list traversal:\n";
     traverse(head);
     
+    // A list handle appends in O(1) and splices whole lists in O(1).
+    List<int> first;
+    List<int> second;
+    for (int i = 1; i <= 5; ++i) {
+        push_back(first, i);
+        push_back(second, 10 * i);
+    }
+    splice(first, second);
+    remove(first, 50);
+    std::cout << "\nList handle after splicing 10..50 onto 1..5 and removing 50:\n";
+    traverse(first);
+    std::cout << "Size: " << size(first) << ", tail: " << first.tail->data << "\n";
+
+    // Splicing a list onto itself is a no-op, and handles move without copying nodes.
+    splice(first, first);
+    List<int> moved = std::move(first);
+    std::cout << "Moved-to size after a self-splice: " << size(moved)
+              << ", moved-from size: " << size(first) << "\n";
+    
+    // The same operations on a list whose nodes live in a monotonic arena.
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaList<int> list{.alloc = &arena};
+    for (int i = 1; i <= 5; ++i) {
+        append(list, i);
+    }
+    prepend(list, 0);
+    remove(list, 3);
+    reverse(list);
+    std::cout << "\nArena list after prepend 0, remove 3 and reverse:\n";
+    traverse(list);
+    std::cout << "Count: " << count(list) << "\n";
+    
+    // Releasing the arena frees every node at once.
+    release(list, arena);
+    std::cout << "Arena released: " << (list.head ? "list still exists" : "head is nullptr") << "\n";
+    
     return 0;
 }
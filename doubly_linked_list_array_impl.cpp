@@ -1,97 +1,154 @@
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
+#include "node_pool_compact.hpp"
+#include "node_pool_scan.hpp"
 
 // Doubly linked list structure.
+template <typename T, typename Index = int>
 struct DoublyLinkedList {
-    int head{-1}; // Index of the first node.
-    int tail{-1}; // Index of the last node.
+    Index head{NULL_INDEX<Index>}; // Index of the first node.
+    Index tail{NULL_INDEX<Index>}; // Index of the last node.
 
     // Free node stack and node arrays.
     struct {
         struct {
-            std::unique_ptr<float[]> data;   // Node values.
-            std::unique_ptr<int[]> next;       // Next pointers (indices).
-            std::unique_ptr<int[]> prev;       // Previous pointers (indices).
+            std::unique_ptr<T[]> data;     // Node values.
+            std::unique_ptr<Index[]> next; // Next pointers (indices).
+            std::unique_ptr<Index[]> prev; // Previous pointers (indices).
         } nodes;
-        std::unique_ptr<int[]> next_free;      // Free list linking (free stack).
-        std::unique_ptr<bool[]> allocated;     // Allocation flags.
-        size_t size{0};                        // Total number of nodes.
-        int free_head{-1};                     // Head index for free list.
+        NodePool<Index> slots; // Occupancy bitmap allocator.
+        bool growable{true};   // Grow the pool when it runs out of free nodes.
     } free_node_stack;
 };
 
 // Initialize the doubly linked list with N nodes.
 // All nodes are initially free.
-void DoublyLinkedList_init(DoublyLinkedList &list, const size_t N) {
-    list.head = -1;
-    list.tail = -1;
-    list.free_node_stack.size = N;
+template <typename T, typename Index>
+void DoublyLinkedList_init(DoublyLinkedList<T, Index> &list, const size_t N) {
+    list.head = NULL_INDEX<Index>;
+    list.tail = NULL_INDEX<Index>;
+    NodePool_init(list.free_node_stack.slots, N);
     
-    list.free_node_stack.nodes.data = std::make_unique<float[]>(N);
-    list.free_node_stack.nodes.next = std::make_unique<int[]>(N);
-    list.free_node_stack.nodes.prev = std::make_unique<int[]>(N);
-    list.free_node_stack.next_free = std::make_unique<int[]>(N);
-    list.free_node_stack.allocated = std::make_unique<bool[]>(N);
-    list.free_node_stack.free_head = 0; // Free list starts at index 0
+    list.free_node_stack.nodes.data = make_payload_array<T>(N);
+    list.free_node_stack.nodes.next = std::make_unique<Index[]>(N);
+    list.free_node_stack.nodes.prev = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i) {
-        list.free_node_stack.nodes.data[i] = 0.0f;
-        list.free_node_stack.nodes.next[i] = -1;
-        list.free_node_stack.nodes.prev[i] = -1;
-        list.free_node_stack.allocated[i] = false;
-        list.free_node_stack.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+        list.free_node_stack.nodes.next[i] = NULL_INDEX<Index>;
+        list.free_node_stack.nodes.prev[i] = NULL_INDEX<Index>;
+    }
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool DoublyLinkedList_growPool(DoublyLinkedList<T, Index> &list) {
+    const size_t old_size = list.free_node_stack.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(list.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+    auto prev = std::make_unique<Index[]>(new_size);
+
+    std::move(list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.data.get() + old_size, data.get());
+    std::copy_n(list.free_node_stack.nodes.next.get(), old_size, next.get());
+    std::copy_n(list.free_node_stack.nodes.prev.get(), old_size, prev.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        next[i] = NULL_INDEX<Index>;
+        prev[i] = NULL_INDEX<Index>;
     }
+
+    list.free_node_stack.nodes.data = std::move(data);
+    list.free_node_stack.nodes.next = std::move(next);
+    list.free_node_stack.nodes.prev = std::move(prev);
+    return true;
 }
 
-// Allocate a node from the free node stack, setting its value.
+// Shrink the pool to new_size nodes, releasing the node arrays above it.
+// Every node at or above new_size must be free; returns false otherwise.
+template <typename T, typename Index>
+bool DoublyLinkedList_shrinkPool(DoublyLinkedList<T, Index> &list, const size_t new_size) {
+    if (!NodePool_shrink(list.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+    auto prev = std::make_unique<Index[]>(new_size);
+
+    std::move(list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.data.get() + new_size, data.get());
+    std::copy_n(list.free_node_stack.nodes.next.get(), new_size, next.get());
+    std::copy_n(list.free_node_stack.nodes.prev.get(), new_size, prev.get());
+
+    list.free_node_stack.nodes.data = std::move(data);
+    list.free_node_stack.nodes.next = std::move(next);
+    list.free_node_stack.nodes.prev = std::move(prev);
+    return true;
+}
+
+// Allocate the lowest free node from the pool, setting its value.
+// Grows the pool first if every node is in use and the pool is growable.
 // Returns the allocated node index in node_idx.
-void DoublyLinkedList_allocateNode(DoublyLinkedList &list, const float &value, int &node_idx) {
-    node_idx = -1;
-    if (list.free_node_stack.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void DoublyLinkedList_allocateNode(DoublyLinkedList<T, Index> &list, const T &value, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(list.free_node_stack.slots) &&
+        !(list.free_node_stack.growable && DoublyLinkedList_growPool(list))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // "Pop" a node from the free stack.
-    node_idx = list.free_node_stack.free_head;
-    list.free_node_stack.free_head = list.free_node_stack.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(list.free_node_stack.slots, node_idx);
 
     // Initialize the node.
     list.free_node_stack.nodes.data[node_idx] = value;
-    list.free_node_stack.nodes.next[node_idx] = -1;
-    list.free_node_stack.nodes.prev[node_idx] = -1;
-    list.free_node_stack.allocated[node_idx] = true;
+    list.free_node_stack.nodes.next[node_idx] = NULL_INDEX<Index>;
+    list.free_node_stack.nodes.prev[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by pushing it back onto the free node stack.
-void DoublyLinkedList_deallocateNode(DoublyLinkedList &list, const size_t idx) {
-    if (idx >= list.free_node_stack.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+// Deallocate a node by returning it to the pool.
+template <typename T, typename Index>
+void DoublyLinkedList_deallocateNode(DoublyLinkedList<T, Index> &list, const size_t idx) {
+    if (idx >= list.free_node_stack.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
-    if (!list.free_node_stack.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(list.free_node_stack.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     // Reset the node.
-    list.free_node_stack.nodes.data[idx] = 0.0f;
-    list.free_node_stack.nodes.next[idx] = -1;
-    list.free_node_stack.nodes.prev[idx] = -1;
-    list.free_node_stack.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        list.free_node_stack.nodes.data[idx] = T{}; // Release resources held by the payload.
+    list.free_node_stack.nodes.next[idx] = NULL_INDEX<Index>;
+    list.free_node_stack.nodes.prev[idx] = NULL_INDEX<Index>;
     
-    // "Push" the node back onto the free stack.
-    list.free_node_stack.next_free[idx] = list.free_node_stack.free_head;
-    list.free_node_stack.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(list.free_node_stack.slots, idx);
 }
 
 // Append a value to the end of the doubly linked list.
-void DoublyLinkedList_append(DoublyLinkedList &list, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void DoublyLinkedList_append(DoublyLinkedList<T, Index> &list, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     DoublyLinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
     // If the list is empty, set head and tail.
-    if (list.head == -1) {
+    if (list.head == NULL_INDEX<Index>) {
         list.head = new_node;
         list.tail = new_node;
     } else {
@@ -103,13 +160,14 @@ void DoublyLinkedList_append(DoublyLinkedList &list, const float &value) {
 }
 
 // Prepend a value to the beginning of the doubly linked list.
-void DoublyLinkedList_prepend(DoublyLinkedList &list, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void DoublyLinkedList_prepend(DoublyLinkedList<T, Index> &list, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     DoublyLinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
-    if (list.head == -1) {
+    if (list.head == NULL_INDEX<Index>) {
         // List is empty.
         list.head = new_node;
         list.tail = new_node;
@@ -122,18 +180,19 @@ void DoublyLinkedList_prepend(DoublyLinkedList &list, const float &value) {
 }
 
 // Insert a value after the node at a specified index.
-void DoublyLinkedList_insertAfter(DoublyLinkedList &list, int node_idx, const float &value) {
-    if (node_idx < 0 || static_cast<size_t>(node_idx) >= list.free_node_stack.size ||
-        !list.free_node_stack.allocated[node_idx]) {
-        std::cerr << "Error: Invalid node index for insertion." << std::endl;
+template <typename T, typename Index>
+void DoublyLinkedList_insertAfter(DoublyLinkedList<T, Index> &list, Index node_idx, const T &value) {
+    if (static_cast<size_t>(node_idx) >= list.free_node_stack.slots.size ||
+        !NodePool_isAllocated(list.free_node_stack.slots, node_idx)) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Invalid node index for insertion.");
         return;
     }
-    int new_node = -1;
+    Index new_node = NULL_INDEX<Index>;
     DoublyLinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
-    int next_node = list.free_node_stack.nodes.next[node_idx];
+    Index next_node = list.free_node_stack.nodes.next[node_idx];
     
     // Set new node's pointers.
     list.free_node_stack.nodes.prev[new_node] = node_idx;
@@ -141,7 +200,7 @@ void DoublyLinkedList_insertAfter(DoublyLinkedList &list, int node_idx, const fl
     
     // Link the new node into the list.
     list.free_node_stack.nodes.next[node_idx] = new_node;
-    if (next_node != -1) {
+    if (next_node != NULL_INDEX<Index>) {
         list.free_node_stack.nodes.prev[next_node] = new_node;
     } else {
         // New node is now the tail.
@@ -150,42 +209,44 @@ void DoublyLinkedList_insertAfter(DoublyLinkedList &list, int node_idx, const fl
 }
 
 // Search for the first node containing the specified value.
-// Returns the node index in result if found, otherwise returns -1.
-void DoublyLinkedList_search(DoublyLinkedList &list, const float &value, int &result) {
-    int current = list.head;
-    while (current != -1) {
+// Returns the node index in result if found, otherwise returns NULL_INDEX.
+template <typename T, typename Index>
+void DoublyLinkedList_search(DoublyLinkedList<T, Index> &list, const T &value, Index &result) {
+    Index current = list.head;
+    while (current != NULL_INDEX<Index>) {
         if (list.free_node_stack.nodes.data[current] == value) {
             result = current;
             return;
         }
         current = list.free_node_stack.nodes.next[current];
     }
-    result = -1;
+    result = NULL_INDEX<Index>;
 }
 
 // Delete the first node found that contains the specified value.
-void DoublyLinkedList_delete(DoublyLinkedList &list, const float &value) {
-    int current = list.head;
-    while (current != -1) {
+template <typename T, typename Index>
+void DoublyLinkedList_delete(DoublyLinkedList<T, Index> &list, const T &value) {
+    Index current = list.head;
+    while (current != NULL_INDEX<Index>) {
         if (list.free_node_stack.nodes.data[current] == value)
             break;
         current = list.free_node_stack.nodes.next[current];
     }
-    if (current == -1) {
-        std::cerr << "Value " << value << " not found." << std::endl;
+    if (current == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Value " << value << " not found.");
         return;
     }
 
-    int prev_node = list.free_node_stack.nodes.prev[current];
-    int next_node = list.free_node_stack.nodes.next[current];
+    Index prev_node = list.free_node_stack.nodes.prev[current];
+    Index next_node = list.free_node_stack.nodes.next[current];
 
     // Update head and tail if necessary.
-    if (prev_node != -1)
+    if (prev_node != NULL_INDEX<Index>)
         list.free_node_stack.nodes.next[prev_node] = next_node;
     else
         list.head = next_node;
 
-    if (next_node != -1)
+    if (next_node != NULL_INDEX<Index>)
         list.free_node_stack.nodes.prev[next_node] = prev_node;
     else
         list.tail = prev_node;
@@ -194,11 +255,64 @@ void DoublyLinkedList_delete(DoublyLinkedList &list, const float &value) {
     DoublyLinkedList_deallocateNode(list, current);
 }
 
+// Check whether any node holds the specified value, in any order.
+// Streams the payload array with SIMD compares instead of following next links.
+template <typename T, typename Index>
+bool DoublyLinkedList_contains(const DoublyLinkedList<T, Index> &list, const T &value) {
+    return NodePool_contains(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), value);
+}
+
+// Count the nodes whose value satisfies compare(value, threshold), for
+// example DoublyLinkedList_countIf(list, std::greater<>{}, t) counts values above t.
+// Standard comparators on float and int32 payloads are evaluated with SIMD.
+template <typename T, typename Index, typename Compare>
+size_t DoublyLinkedList_countIf(const DoublyLinkedList<T, Index> &list, const Compare &compare, const T &threshold) {
+    return NodePool_countIf(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), compare, threshold);
+}
+
+// Collect the indices of the nodes whose value satisfies compare(value, threshold).
+// Indices come out in pool order, not list order.
+template <typename T, typename Index, typename Compare>
+void DoublyLinkedList_findAll(const DoublyLinkedList<T, Index> &list, const Compare &compare, const T &threshold, std::vector<Index> &result) {
+    result.clear();
+    NodePool_findAll(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), compare, threshold, result);
+}
+
+// Run one slice of an incremental compaction, handling at most budget nodes.
+// Renumbers the live nodes so that traversal from the head is one
+// sequential sweep through memory, and leaves the free nodes as one
+// contiguous tail. Other operations may run between slices. Start with a
+// default-constructed state; returns true once the pass is complete.
+template <typename T, typename Index>
+bool DoublyLinkedList_compactStep(DoublyLinkedList<T, Index> &list, NodePoolCompaction<Index> &state, const size_t budget) {
+    auto make_links = [&list] {
+        return NodePoolLinks<T, Index>{list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.next.get(), list.free_node_stack.nodes.prev.get(),
+                                       &list.head, &list.tail, false};
+    };
+    auto grow = [&list] { return list.free_node_stack.growable && DoublyLinkedList_growPool(list); };
+    auto shrink = [&list](const size_t new_size) { DoublyLinkedList_shrinkPool(list, new_size); };
+    return NodePool_compactStep(list.free_node_stack.slots, state, budget, make_links, grow, shrink);
+}
+
+// Compact the doubly linked list in a single pass.
+template <typename T, typename Index>
+void DoublyLinkedList_compact(DoublyLinkedList<T, Index> &list) {
+    NodePoolCompaction<Index> state;
+    DoublyLinkedList_compactStep(list, state, std::numeric_limits<size_t>::max());
+}
+
+// Fraction of links that do not lead to the adjacent node slot (0: fully sequential).
+template <typename T, typename Index>
+double DoublyLinkedList_fragmentation(const DoublyLinkedList<T, Index> &list) {
+    return NodePool_fragmentation(list.free_node_stack.nodes.next.get(), list.head, false);
+}
+
 // Print the list from head to tail.
-void DoublyLinkedList_print(const DoublyLinkedList &list) {
-    int current = list.head;
+template <typename T, typename Index>
+void DoublyLinkedList_print(const DoublyLinkedList<T, Index> &list) {
+    Index current = list.head;
     std::cout << "DoublyLinkedList: ";
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         std::cout << list.free_node_stack.nodes.data[current] << " ";
         current = list.free_node_stack.nodes.next[current];
     }
@@ -208,7 +322,7 @@ void DoublyLinkedList_print(const DoublyLinkedList &list) {
 // Demonstration of doubly linked list operations.
 int main() {
     constexpr size_t N = 10;
-    DoublyLinkedList list;
+    DoublyLinkedList<float> list;
     
     // Initialize the doubly linked list with N nodes.
     DoublyLinkedList_init(list, N);
@@ -234,5 +348,31 @@ int main() {
     DoublyLinkedList_delete(list, 2.2f);
     DoublyLinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3
     
+    // Append past the initial capacity; the pool grows on demand.
+    for (int i = 0; i < static_cast<int>(N); ++i)
+        DoublyLinkedList_append(list, static_cast<float>(10 + i));
+    std::cout << "Pool size after growth: " << list.free_node_stack.slots.size << std::endl;
+    DoublyLinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3 10 ... 19
+    
+    // Order-independent membership and filter queries scan the node pool directly.
+    std::cout << "Contains 1.5: " << DoublyLinkedList_contains(list, 1.5f)
+              << ", contains 2.2: " << DoublyLinkedList_contains(list, 2.2f) << std::endl;  // Expected: 1, 0
+    std::cout << "Values above 12: " << DoublyLinkedList_countIf(list, std::greater<>{}, 12.0f) << std::endl;  // Expected: 7
+    std::vector<int> small;
+    DoublyLinkedList_findAll(list, std::less<>{}, 2.0f, small);
+    std::cout << "Nodes holding values below 2:";
+    for (int idx : small)
+        std::cout << " " << idx << "=" << list.free_node_stack.nodes.data[idx];
+    std::cout << std::endl;  // Expected: the nodes holding 0, 1.1 and 1.5
+    
+    // Compaction renumbers the nodes in traversal order, here in slices of at most 4 nodes.
+    std::cout << "Fragmentation before compaction: " << DoublyLinkedList_fragmentation(list) << std::endl;
+    NodePoolCompaction<int> compaction;
+    int slices = 1;
+    while (!DoublyLinkedList_compactStep(list, compaction, 4))
+        ++slices;
+    std::cout << "Fragmentation after " << slices << " slices: " << DoublyLinkedList_fragmentation(list) << std::endl;  // Expected: 0
+    DoublyLinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3 10 ... 19
+    
     return 0;
 }
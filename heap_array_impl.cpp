@@ -1,6 +1,20 @@
+#include <algorithm>
+#include <bit>
+#include <expected>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <new>
+#include <span>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 // Heap structure implemented as a min-heap.
 struct Heap {
@@ -61,24 +75,29 @@ void Heap_bubbleDown(Heap &heap, size_t i) {
     }
 }
 
-// Insert a new key into the heap.
-void Heap_insert(Heap &heap, const float key) {
-    if (heap.size >= heap.capacity) {
-        std::cerr << "Error: Heap is full." << std::endl;
-        return;
-    }
+// Insert a new key into the heap without reporting an error.
+// Returns ContainerError::Full if the heap is at capacity.
+std::expected<void, ContainerError> Heap_tryInsert(Heap &heap, const float key) {
+    if (heap.size >= heap.capacity)
+        return std::unexpected(ContainerError::Full);
     // Place the new key at the end and bubble up.
     heap.data[heap.size] = key;
     Heap_bubbleUp(heap, heap.size);
     ++heap.size;
+    return {};
 }
 
-// Remove and return the minimum element (root) from the heap.
-float Heap_removeMin(Heap &heap) {
-    if (heap.size == 0) {
-        std::cerr << "Error: Heap is empty." << std::endl;
-        return 0.0f; // Alternatively, throw an exception.
-    }
+// Insert a new key into the heap.
+void Heap_insert(Heap &heap, const float key) {
+    if (auto inserted = Heap_tryInsert(heap, key); !inserted)
+        CONTAINER_ERROR(inserted.error(), "Heap is full.");
+}
+
+// Remove and return the minimum element (root) from the heap without reporting an error.
+// Returns ContainerError::Empty if the heap is empty.
+std::expected<float, ContainerError> Heap_tryRemoveMin(Heap &heap) {
+    if (heap.size == 0)
+        return std::unexpected(ContainerError::Empty);
     float minValue = heap.data[0];
     // Replace root with the last element.
     heap.data[0] = heap.data[heap.size - 1];
@@ -87,10 +106,20 @@ float Heap_removeMin(Heap &heap) {
     return minValue;
 }
 
+// Remove and return the minimum element (root) from the heap.
+float Heap_removeMin(Heap &heap) {
+    auto minValue = Heap_tryRemoveMin(heap);
+    if (!minValue) {
+        CONTAINER_ERROR(minValue.error(), "Heap is empty.");
+        return 0.0f; // Alternatively, throw an exception.
+    }
+    return *minValue;
+}
+
 // Peek at the minimum element in the heap.
 float Heap_peek(const Heap &heap) {
     if (heap.size == 0) {
-        std::cerr << "Error: Heap is empty." << std::endl;
+        CONTAINER_ERROR(ContainerError::Empty, "Heap is empty.");
         return 0.0f;
     }
     return heap.data[0];
@@ -105,6 +134,374 @@ void Heap_print(const Heap &heap) {
     std::cout << std::endl;
 }
 
+// Replace the heap contents with keys using Floyd's bottom-up heapify, O(N).
+// The capacity grows if the keys do not fit.
+void Heap_buildFrom(Heap &heap, std::span<const float> keys) {
+    if (keys.size() > heap.capacity) {
+        heap.data = std::make_unique<float[]>(keys.size());
+        heap.capacity = keys.size();
+    }
+    std::copy(keys.begin(), keys.end(), heap.data.get());
+    heap.size = keys.size();
+    // Sift down every internal node, deepest first.
+    for (size_t i = heap.size / 2; i-- > 0;)
+        Heap_bubbleDown(heap, i);
+}
+
+// Insert a batch of keys with a single capacity check.
+// A batch at least as large as the heap is appended and re-heapified
+// bottom-up in O(size + n); a smaller one is sifted up key by key.
+void Heap_insertBatch(Heap &heap, std::span<const float> keys) {
+    if (keys.size() > heap.capacity - heap.size) {
+        CONTAINER_ERROR(ContainerError::Full, "Heap is full.");
+        return;
+    }
+    const size_t old_size = heap.size;
+    std::copy(keys.begin(), keys.end(), heap.data.get() + old_size);
+    heap.size += keys.size();
+    if (keys.size() >= old_size) {
+        for (size_t i = heap.size / 2; i-- > 0;)
+            Heap_bubbleDown(heap, i);
+    } else {
+        for (size_t i = old_size; i < heap.size; ++i)
+            Heap_bubbleUp(heap, i);
+    }
+}
+
+// Remove the out.size() smallest elements (or all, if fewer) into out in ascending order.
+// Each removal walks the hole left at the root down to a leaf along the
+// smaller children and sifts the last element up from there, which
+// needs about half the comparisons of a regular bubble down.
+// Returns the number of elements removed.
+size_t Heap_removeMinK(Heap &heap, std::span<float> out) {
+    const size_t count = std::min(out.size(), heap.size);
+    for (size_t k = 0; k < count; ++k) {
+        out[k] = heap.data[0];
+        const float last = heap.data[--heap.size];
+        // Move the hole down to a leaf.
+        size_t hole = 0;
+        size_t child = 1;
+        while (child < heap.size) {
+            if (child + 1 < heap.size && heap.data[child + 1] < heap.data[child])
+                ++child;
+            heap.data[hole] = heap.data[child];
+            hole = child;
+            child = 2 * hole + 1;
+        }
+        // Drop the former last element into the hole and let it rise.
+        heap.data[hole] = last;
+        Heap_bubbleUp(heap, hole);
+    }
+    return count;
+}
+
+// Indexed (addressable) binary min-heap.
+// Items are identified by a handle in [0, capacity). Alongside the keys,
+// a structure of arrays records which handle sits in each heap slot and
+// which slot holds each handle, so a handle is found in O(1) and can be
+// re-prioritized or erased in O(log n).
+struct IndexedHeap {
+    size_t capacity{0};                       // Total capacity (number of handles).
+    size_t size{0};                           // Current number of elements in the heap.
+    std::unique_ptr<float[]> data{nullptr};   // Keys in heap order.
+    std::unique_ptr<int[]> items{nullptr};    // Handle stored in each heap slot.
+    std::unique_ptr<int[]> position{nullptr}; // Heap slot of each handle, or -1 if absent.
+};
+
+// Initialize the IndexedHeap for handles 0..capacity-1.
+void IndexedHeap_init(IndexedHeap &heap, const size_t capacity) {
+    heap.capacity = capacity;
+    heap.size = 0;
+    heap.data = std::make_unique<float[]>(capacity);
+    heap.items = std::make_unique<int[]>(capacity);
+    heap.position = std::make_unique<int[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        heap.data[i] = 0.0f;
+        heap.items[i] = -1;
+        heap.position[i] = -1;
+    }
+}
+
+// Check whether a handle is currently in the heap.
+bool IndexedHeap_contains(const IndexedHeap &heap, const int handle) {
+    return handle >= 0 && static_cast<size_t>(handle) < heap.capacity && heap.position[handle] != -1;
+}
+
+// Store a key/handle pair in slot i and record the handle's position.
+void IndexedHeap_place(IndexedHeap &heap, const size_t i, const float key, const int handle) {
+    heap.data[i] = key;
+    heap.items[i] = handle;
+    heap.position[handle] = static_cast<int>(i);
+}
+
+// Move the entry at slot i up until its parent is not larger.
+void IndexedHeap_bubbleUp(IndexedHeap &heap, size_t i) {
+    const float key = heap.data[i];
+    const int handle = heap.items[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!(key < heap.data[parent]))
+            break;
+        IndexedHeap_place(heap, i, heap.data[parent], heap.items[parent]);
+        i = parent;
+    }
+    IndexedHeap_place(heap, i, key, handle);
+}
+
+// Move the entry at slot i down until no child is smaller.
+void IndexedHeap_bubbleDown(IndexedHeap &heap, size_t i) {
+    const float key = heap.data[i];
+    const int handle = heap.items[i];
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= heap.size)
+            break;
+        if (child + 1 < heap.size && heap.data[child + 1] < heap.data[child])
+            ++child;
+        if (!(heap.data[child] < key))
+            break;
+        IndexedHeap_place(heap, i, heap.data[child], heap.items[child]);
+        i = child;
+    }
+    IndexedHeap_place(heap, i, key, handle);
+}
+
+// Insert a handle with the given key.
+void IndexedHeap_push(IndexedHeap &heap, const int handle, const float key) {
+    if (handle < 0 || static_cast<size_t>(handle) >= heap.capacity) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Handle " << handle << " out of bounds.");
+        return;
+    }
+    if (heap.position[handle] != -1) {
+        CONTAINER_ERROR(ContainerError::Duplicate, "Handle " << handle << " is already in the heap.");
+        return;
+    }
+    IndexedHeap_place(heap, heap.size, key, handle);
+    IndexedHeap_bubbleUp(heap, heap.size);
+    ++heap.size;
+}
+
+// Lower the key of a handle that is in the heap.
+void IndexedHeap_decreaseKey(IndexedHeap &heap, const int handle, const float key) {
+    if (!IndexedHeap_contains(heap, handle)) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Handle " << handle << " not found.");
+        return;
+    }
+    if (heap.data[heap.position[handle]] < key) {
+        CONTAINER_ERROR(ContainerError::InvalidKey, "New key is larger than the current key.");
+        return;
+    }
+    size_t i = heap.position[handle];
+    heap.data[i] = key;
+    IndexedHeap_bubbleUp(heap, i);
+}
+
+// Raise the key of a handle that is in the heap.
+void IndexedHeap_increaseKey(IndexedHeap &heap, const int handle, const float key) {
+    if (!IndexedHeap_contains(heap, handle)) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Handle " << handle << " not found.");
+        return;
+    }
+    if (key < heap.data[heap.position[handle]]) {
+        CONTAINER_ERROR(ContainerError::InvalidKey, "New key is smaller than the current key.");
+        return;
+    }
+    size_t i = heap.position[handle];
+    heap.data[i] = key;
+    IndexedHeap_bubbleDown(heap, i);
+}
+
+// Remove a handle from the heap, wherever it sits.
+void IndexedHeap_erase(IndexedHeap &heap, const int handle) {
+    if (!IndexedHeap_contains(heap, handle)) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Handle " << handle << " not found.");
+        return;
+    }
+    size_t i = heap.position[handle];
+    heap.position[handle] = -1;
+    --heap.size;
+    if (i == heap.size)
+        return;
+    // Fill the gap with the last entry, which may need to move either way.
+    const int moved = heap.items[heap.size];
+    IndexedHeap_place(heap, i, heap.data[heap.size], moved);
+    IndexedHeap_bubbleUp(heap, i);
+    IndexedHeap_bubbleDown(heap, heap.position[moved]);
+}
+
+// Remove the entry with the minimum key.
+// Returns its key, and its handle via handle.
+float IndexedHeap_popMin(IndexedHeap &heap, int &handle) {
+    handle = -1;
+    if (heap.size == 0) {
+        CONTAINER_ERROR(ContainerError::Empty, "Heap is empty.");
+        return 0.0f;
+    }
+    float minValue = heap.data[0];
+    handle = heap.items[0];
+    IndexedHeap_erase(heap, handle);
+    return minValue;
+}
+
+// Deleter for cache-line aligned float arrays.
+struct AlignedFloatDeleter {
+    void operator()(float *ptr) const {
+        ::operator delete[](ptr, std::align_val_t{64});
+    }
+};
+
+// Min-heap with D children per node, intended for D = 4 or 8.
+// Element k is stored at data[k + D - 1], which places the D children of
+// every node at a D-aligned offset. With 64-byte aligned storage, a whole
+// sibling group then sits in a single cache line. Slots past the last
+// element hold +infinity, so a sibling group can always be compared as a
+// full vector without per-child bounds checks.
+template <std::size_t D>
+struct DaryHeap {
+    static_assert(D == 2 || D == 4 || D == 8 || D == 16, "D must be 2, 4, 8 or 16");
+
+    size_t capacity{0};                                          // Total capacity of the heap.
+    size_t size{0};                                              // Current number of elements in the heap.
+    std::unique_ptr<float[], AlignedFloatDeleter> data{nullptr}; // Padded, aligned element storage.
+};
+
+// Initialize the DaryHeap with a given capacity.
+template <std::size_t D>
+void DaryHeap_init(DaryHeap<D> &heap, const size_t capacity) {
+    // Room for the D - 1 leading pad slots plus the last parent's full child group,
+    // rounded up to whole cache lines.
+    const size_t slots = (capacity + 2 * D + 15) & ~static_cast<size_t>(15);
+    heap.capacity = capacity;
+    heap.size = 0;
+    heap.data.reset(static_cast<float *>(::operator new[](slots * sizeof(float), std::align_val_t{64})));
+    for (size_t i = 0; i < slots; ++i) {
+        heap.data[i] = std::numeric_limits<float>::infinity();
+    }
+}
+
+// Return the offset (0..D-1) of the smallest value in a D-aligned sibling group.
+template <std::size_t D>
+size_t DaryHeap_minChild(const float *group) {
+#if defined(__SSE2__)
+    if constexpr (D % 4 == 0) {
+        // Vertical min across the 4-wide lanes, then a horizontal min within the lane.
+        __m128 lanes[D / 4];
+        __m128 m = lanes[0] = _mm_load_ps(group);
+        for (size_t i = 1; i < D / 4; ++i) {
+            lanes[i] = _mm_load_ps(group + 4 * i);
+            m = _mm_min_ps(m, lanes[i]);
+        }
+        m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+        // Locate the first lane equal to the minimum. With NaN in the group
+        // no lane may compare equal; the scalar loop below handles that case.
+        unsigned mask = 0;
+        for (size_t i = 0; i < D / 4; ++i)
+            mask |= static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(lanes[i], m))) << (4 * i);
+        if (mask != 0)
+            return static_cast<size_t>(std::countr_zero(mask));
+    }
+#endif
+    size_t smallest = 0;
+    for (size_t i = 1; i < D; ++i)
+        if (group[i] < group[smallest])
+            smallest = i;
+    return smallest;
+}
+
+// Move the element at index i up until its parent is not larger.
+template <std::size_t D>
+void DaryHeap_bubbleUp(DaryHeap<D> &heap, size_t i) {
+    float *slots = heap.data.get() + (D - 1);
+    const float key = slots[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / D;
+        if (!(key < slots[parent]))
+            break;
+        slots[i] = slots[parent];
+        i = parent;
+    }
+    slots[i] = key;
+}
+
+// Move the element at index i down until no child is smaller.
+template <std::size_t D>
+void DaryHeap_bubbleDown(DaryHeap<D> &heap, size_t i) {
+    float *slots = heap.data.get() + (D - 1);
+    const float key = slots[i];
+    while (true) {
+        size_t first_child = D * i + 1;
+        if (first_child >= heap.size)
+            break;
+        size_t smallest = first_child + DaryHeap_minChild<D>(slots + first_child);
+        if (!(slots[smallest] < key))
+            break;
+        slots[i] = slots[smallest];
+        i = smallest;
+    }
+    slots[i] = key;
+}
+
+// Insert a new key into the heap.
+template <std::size_t D>
+void DaryHeap_insert(DaryHeap<D> &heap, const float key) {
+    if (heap.size >= heap.capacity) {
+        CONTAINER_ERROR(ContainerError::Full, "Heap is full.");
+        return;
+    }
+    heap.data[heap.size + D - 1] = key;
+    DaryHeap_bubbleUp(heap, heap.size);
+    ++heap.size;
+}
+
+// Remove and return the minimum element (root) from the heap without reporting an error.
+// Returns ContainerError::Empty if the heap is empty.
+template <std::size_t D>
+std::expected<float, ContainerError> DaryHeap_tryRemoveMin(DaryHeap<D> &heap) {
+    if (heap.size == 0)
+        return std::unexpected(ContainerError::Empty);
+    float *slots = heap.data.get() + (D - 1);
+    float minValue = slots[0];
+    --heap.size;
+    // Move the last element to the root and restore the +infinity padding behind it.
+    slots[0] = slots[heap.size];
+    slots[heap.size] = std::numeric_limits<float>::infinity();
+    if (heap.size > 0)
+        DaryHeap_bubbleDown(heap, 0);
+    return minValue;
+}
+
+// Remove and return the minimum element (root) from the heap.
+template <std::size_t D>
+float DaryHeap_removeMin(DaryHeap<D> &heap) {
+    auto minValue = DaryHeap_tryRemoveMin(heap);
+    if (!minValue) {
+        CONTAINER_ERROR(minValue.error(), "Heap is empty.");
+        return 0.0f;
+    }
+    return *minValue;
+}
+
+// Peek at the minimum element in the heap.
+template <std::size_t D>
+float DaryHeap_peek(const DaryHeap<D> &heap) {
+    if (heap.size == 0) {
+        CONTAINER_ERROR(ContainerError::Empty, "Heap is empty.");
+        return 0.0f;
+    }
+    return heap.data[D - 1];
+}
+
+// Print the heap elements (not in sorted order, but in array order).
+template <std::size_t D>
+void DaryHeap_print(const DaryHeap<D> &heap) {
+    std::cout << "DaryHeap<" << D << ">: ";
+    for (size_t i = 0; i < heap.size; ++i) {
+        std::cout << heap.data[i + D - 1] << " ";
+    }
+    std::cout << std::endl;
+}
+
 // Demonstration of heap operations.
 int main() {
     constexpr size_t CAPACITY = 10;
@@ -131,5 +528,77 @@ int main() {
     }
     std::cout << std::endl;
     
+    // Bulk-load a heap from an array, add a batch, then take the three smallest.
+    const float snapshot[] = {9.0f, 4.0f, 7.0f, 1.0f, 8.0f, 2.0f};
+    Heap_buildFrom(heap, snapshot);
+    Heap_print(heap);  // Expected: root should be the minimum value.
+    const float batch[] = {3.0f, 0.5f};
+    Heap_insertBatch(heap, batch);
+    float smallest[3];
+    size_t removed = Heap_removeMinK(heap, smallest);
+    std::cout << "Smallest " << removed << ": ";
+    for (size_t i = 0; i < removed; ++i) {
+        std::cout << smallest[i] << " ";
+    }
+    std::cout << std::endl;  // Expected: 0.5 1 2
+    Heap_print(heap);
+    
+    // Shortest paths from vertex 0 with the indexed heap driving decrease-key.
+    const std::vector<std::vector<std::pair<int, float>>> graph = {
+        {{1, 4.0f}, {2, 1.0f}},  // 0
+        {{3, 1.0f}},             // 1
+        {{1, 2.0f}, {3, 5.0f}},  // 2
+        {{4, 3.0f}},             // 3
+        {},                      // 4
+    };
+    const float INF = std::numeric_limits<float>::infinity();
+    std::vector<float> dist(graph.size(), INF);
+    IndexedHeap frontier;
+    IndexedHeap_init(frontier, graph.size());
+    dist[0] = 0.0f;
+    IndexedHeap_push(frontier, 0, 0.0f);
+    while (frontier.size > 0) {
+        int u;
+        float du = IndexedHeap_popMin(frontier, u);
+        for (const auto &[v, weight] : graph[u]) {
+            if (du + weight < dist[v]) {
+                if (dist[v] == INF)
+                    IndexedHeap_push(frontier, v, du + weight);
+                else
+                    IndexedHeap_decreaseKey(frontier, v, du + weight);
+                dist[v] = du + weight;
+            }
+        }
+    }
+    std::cout << "Shortest distances from 0: ";
+    for (float d : dist) {
+        std::cout << d << " ";
+    }
+    std::cout << std::endl;  // Expected: 0 3 1 4 7
+    
+    // The same operations on 4-ary and 8-ary heaps.
+    DaryHeap<4> heap4;
+    DaryHeap_init(heap4, CAPACITY);
+    DaryHeap<8> heap8;
+    DaryHeap_init(heap8, CAPACITY);
+    for (float key : {5.0f, 3.0f, 8.0f, 1.0f, 4.0f, 9.0f, 2.0f, 7.0f, 6.0f}) {
+        DaryHeap_insert(heap4, key);
+        DaryHeap_insert(heap8, key);
+    }
+    DaryHeap_print(heap4);
+    DaryHeap_print(heap8);
+    
+    std::cout << "Removing elements (d = 4): ";
+    while (heap4.size > 0) {
+        std::cout << DaryHeap_removeMin(heap4) << " ";
+    }
+    std::cout << std::endl;
+    
+    std::cout << "Removing elements (d = 8): ";
+    while (heap8.size > 0) {
+        std::cout << DaryHeap_removeMin(heap8) << " ";
+    }
+    std::cout << std::endl;
+    
     return 0;
 }
@@ -1,30 +1,38 @@
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 
-// Node structure with an integer data and a unique pointer to the next node.
+// Node structure with a value of type T and a unique pointer to the next node.
+template <typename T>
 struct Node {
-    int data{0};
-    std::unique_ptr<Node> next{nullptr};
+    T data{};
+    std::unique_ptr<Node<T>> next{nullptr};
 };
 
 // Helper function: returns the raw pointer from a unique_ptr.
-Node* ptr(const std::unique_ptr<Node>& up) {
+template <typename T>
+Node<T>* ptr(const std::unique_ptr<Node<T>>& up) {
     return up.get();
 }
 
-std::unique_ptr<Node> create_node(int value) {
-    auto node = std::make_unique<Node>();
+template <typename T>
+std::unique_ptr<Node<T>> create_node(const T& value) {
+    auto node = std::make_unique<Node<T>>();
     node->data = value;
     return node;
 }
 
 // Append: Insert a new node with 'value' at the end of the list.
-void append(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+void append(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     if (!head) {
         head = create_node(value);
         return;
     }
-    Node* curr = ptr(head);
+    Node<T>* curr = ptr(head);
     while (curr->next) {
         curr = ptr(curr->next);
     }
@@ -32,15 +40,17 @@ void append(std::unique_ptr<Node>& head, int value) {
 }
 
 // Prepend: Insert a new node with 'value' at the beginning of the list.
-void prepend(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+void prepend(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     auto newNode = create_node(value);
     newNode->next = std::move(head);
     head = std::move(newNode);
 }
 
 // Search: Return a raw pointer to the first node with the given value, or nullptr if not found.
-Node* search(const std::unique_ptr<Node>& head, int value) {
-    Node* curr = ptr(head);
+template <typename T>
+Node<T>* search(const std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
+    Node<T>* curr = ptr(head);
     while (curr) {
         if (curr->data == value)
             return curr;
@@ -51,7 +61,8 @@ Node* search(const std::unique_ptr<Node>& head, int value) {
 
 // Remove: Delete the first node whose data equals 'value'.
 // Returns true if a node was removed, false otherwise.
-bool remove(std::unique_ptr<Node>& head, int value) {
+template <typename T>
+bool remove(std::unique_ptr<Node<T>>& head, const std::type_identity_t<T>& value) {
     if (!head)
         return false;
     
@@ -60,7 +71,7 @@ bool remove(std::unique_ptr<Node>& head, int value) {
         return true;
     }
     
-    Node* curr = ptr(head);
+    Node<T>* curr = ptr(head);
     while (curr->next) {
         if (curr->next->data == value) {
             curr->next = std::move(curr->next->next);
@@ -72,9 +83,10 @@ bool remove(std::unique_ptr<Node>& head, int value) {
 }
 
 // Count: Return the number of nodes in the list.
-int count(const std::unique_ptr<Node>& head) {
+template <typename T>
+int count(const std::unique_ptr<Node<T>>& head) {
     int cnt = 0;
-    Node* curr = ptr(head);
+    Node<T>* curr = ptr(head);
     while (curr) {
         ++cnt;
         curr = ptr(curr->next);
@@ -83,8 +95,9 @@ int count(const std::unique_ptr<Node>& head) {
 }
 
 // Reverse: Reverse the linked list in-place.
-void reverse(std::unique_ptr<Node>& head) {
-    std::unique_ptr<Node> prev = nullptr;
+template <typename T>
+void reverse(std::unique_ptr<Node<T>>& head) {
+    std::unique_ptr<Node<T>> prev = nullptr;
     while (head) {
         auto next = std::move(head->next);
         head->next = std::move(prev);
@@ -95,8 +108,9 @@ void reverse(std::unique_ptr<Node>& head) {
 }
 
 // Traverse: Print the list's elements.
-void traverse(const std::unique_ptr<Node>& head) {
-    Node* curr = ptr(head);
+template <typename T>
+void traverse(const std::unique_ptr<Node<T>>& head) {
+    Node<T>* curr = ptr(head);
     while (curr) {
         std::cout << curr->data << " -> ";
         curr = ptr(curr->next);
@@ -105,14 +119,292 @@ void traverse(const std::unique_ptr<Node>& head) {
 }
 
 // Cleanup: Iteratively clean up the list by moving head along the chain.
-void cleanup(std::unique_ptr<Node>& head) {
+template <typename T>
+void cleanup(std::unique_ptr<Node<T>>& head) {
     while (head) {
         head = std::move(head->next);
     }
 }
 
+// List handle: owns the chain through head and caches its tail and size,
+// so push_back, size and splice are O(1).
+template <typename T>
+struct List {
+    std::unique_ptr<Node<T>> head{nullptr}; // First node.
+    Node<T>* tail{nullptr};                 // Last node.
+    size_t size{0};                         // Number of nodes.
+
+    List() = default;
+    List(List&& other) noexcept
+        : head(std::move(other.head)),
+          tail(std::exchange(other.tail, nullptr)),
+          size(std::exchange(other.size, 0)) {}
+    // Free the old chain before taking over the other list's.
+    List& operator=(List&& other) noexcept {
+        if (this != &other) {
+            cleanup(head);
+            head = std::move(other.head);
+            tail = std::exchange(other.tail, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+    // The handle owns its chain, so it is move-only.
+    List(const List&) = delete;
+    List& operator=(const List&) = delete;
+    // Destroy the nodes iteratively; the default recursive unique_ptr
+    // destruction would overflow the stack on long lists.
+    ~List() {
+        cleanup(head);
+    }
+};
+
+// Push_back: Insert a new node with 'value' at the end of the list in O(1).
+template <typename T>
+void push_back(List<T>& list, const std::type_identity_t<T>& value) {
+    auto node = create_node<T>(value);
+    Node<T>* raw = ptr(node);
+    if (list.tail)
+        list.tail->next = std::move(node);
+    else
+        list.head = std::move(node);
+    list.tail = raw;
+    ++list.size;
+}
+
+// Push_front: Insert a new node with 'value' at the beginning of the list.
+template <typename T>
+void push_front(List<T>& list, const std::type_identity_t<T>& value) {
+    prepend(list.head, value);
+    if (!list.tail)
+        list.tail = ptr(list.head);
+    ++list.size;
+}
+
+// Size: Return the number of nodes in the list in O(1).
+template <typename T>
+size_t size(const List<T>& list) {
+    return list.size;
+}
+
+// Splice: Move every node of 'other' to the end of 'list' in O(1), leaving 'other' empty.
+template <typename T>
+void splice(List<T>& list, List<T>& other) {
+    if (&list == &other || !other.head)
+        return;
+    if (list.tail)
+        list.tail->next = std::move(other.head);
+    else
+        list.head = std::move(other.head);
+    list.tail = other.tail;
+    list.size += other.size;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+// Append: Adapter for push_back.
+template <typename T>
+void append(List<T>& list, const std::type_identity_t<T>& value) {
+    push_back(list, value);
+}
+
+// Prepend: Adapter for push_front.
+template <typename T>
+void prepend(List<T>& list, const std::type_identity_t<T>& value) {
+    push_front(list, value);
+}
+
+// Search: Return a raw pointer to the first node with the given value, or nullptr if not found.
+template <typename T>
+Node<T>* search(const List<T>& list, const std::type_identity_t<T>& value) {
+    return search(list.head, value);
+}
+
+// Remove: Delete the first node whose data equals 'value', keeping tail and size current.
+// Returns true if a node was removed, false otherwise.
+template <typename T>
+bool remove(List<T>& list, const std::type_identity_t<T>& value) {
+    Node<T>* prev = nullptr;
+    for (Node<T>* curr = ptr(list.head); curr; prev = curr, curr = ptr(curr->next)) {
+        if (curr->data != value)
+            continue;
+        if (curr == list.tail)
+            list.tail = prev;
+        (prev ? prev->next : list.head) = std::move(curr->next);
+        --list.size;
+        return true;
+    }
+    return false;
+}
+
+// Count: Adapter for size.
+template <typename T>
+int count(const List<T>& list) {
+    return static_cast<int>(list.size);
+}
+
+// Reverse: Reverse the list in-place; the old head becomes the tail.
+template <typename T>
+void reverse(List<T>& list) {
+    list.tail = ptr(list.head);
+    reverse(list.head);
+}
+
+// Traverse: Print the list's elements.
+template <typename T>
+void traverse(const List<T>& list) {
+    traverse(list.head);
+}
+
+// Cleanup: Free every node and reset the handle.
+template <typename T>
+void cleanup(List<T>& list) {
+    cleanup(list.head);
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+// Node of an arena-backed list. The memory resource owns the node, so next is a raw pointer.
+template <typename T>
+struct ArenaNode {
+    T data{};
+    ArenaNode<T>* next{nullptr};
+};
+
+// Singly linked list whose nodes come from a std::pmr memory resource.
+// Backed by a std::pmr::monotonic_buffer_resource, creating a node is a
+// pointer bump into contiguous blocks, and release() tears the whole list
+// down at once. Memory of removed nodes is reclaimed only when the
+// resource is released; use a std::pmr::unsynchronized_pool_resource for
+// long-lived lists with heavy removal. Create one with
+// ArenaList<T> list{.alloc = &resource}.
+template <typename T>
+struct ArenaList {
+    ArenaNode<T>* head{nullptr};              // First node.
+    ArenaNode<T>* tail{nullptr};              // Last node, so append is O(1).
+    size_t size{0};                           // Number of nodes.
+    std::pmr::polymorphic_allocator<> alloc;  // Source of node memory.
+};
+
+// Create a new node with the given value in the list's memory resource.
+template <typename T>
+ArenaNode<T>* create_node(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = list.alloc.template new_object<ArenaNode<T>>();
+    node->data = value;
+    return node;
+}
+
+// Append: Insert a new node with 'value' at the end of the list.
+template <typename T>
+void append(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = create_node(list, value);
+    if (list.tail)
+        list.tail->next = node;
+    else
+        list.head = node;
+    list.tail = node;
+    ++list.size;
+}
+
+// Prepend: Insert a new node with 'value' at the beginning of the list.
+template <typename T>
+void prepend(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* node = create_node(list, value);
+    node->next = list.head;
+    list.head = node;
+    if (!list.tail)
+        list.tail = node;
+    ++list.size;
+}
+
+// Search: Return a pointer to the first node with the given value, or nullptr if not found.
+template <typename T>
+ArenaNode<T>* search(const ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    for (ArenaNode<T>* curr = list.head; curr; curr = curr->next)
+        if (curr->data == value)
+            return curr;
+    return nullptr;
+}
+
+// Remove: Delete the first node whose data equals 'value'.
+// Returns true if a node was removed, false otherwise.
+template <typename T>
+bool remove(ArenaList<T>& list, const std::type_identity_t<T>& value) {
+    ArenaNode<T>* prev = nullptr;
+    for (ArenaNode<T>* curr = list.head; curr; prev = curr, curr = curr->next) {
+        if (curr->data != value)
+            continue;
+        (prev ? prev->next : list.head) = curr->next;
+        if (curr == list.tail)
+            list.tail = prev;
+        list.alloc.delete_object(curr);
+        --list.size;
+        return true;
+    }
+    return false;
+}
+
+// Count: Return the number of nodes in the list, in O(1).
+template <typename T>
+int count(const ArenaList<T>& list) {
+    return static_cast<int>(list.size);
+}
+
+// Reverse: Reverse the linked list in-place.
+template <typename T>
+void reverse(ArenaList<T>& list) {
+    ArenaNode<T>* prev = nullptr;
+    ArenaNode<T>* curr = list.head;
+    list.tail = curr;
+    while (curr) {
+        ArenaNode<T>* next = curr->next;
+        curr->next = prev;
+        prev = curr;
+        curr = next;
+    }
+    list.head = prev;
+}
+
+// Traverse: Print the list's elements.
+template <typename T>
+void traverse(const ArenaList<T>& list) {
+    for (const ArenaNode<T>* curr = list.head; curr; curr = curr->next)
+        std::cout << curr->data << " -> ";
+    std::cout << "null\n";
+}
+
+// Cleanup: Destroy and deallocate the nodes one by one. Works with any memory resource.
+template <typename T>
+void cleanup(ArenaList<T>& list) {
+    while (list.head) {
+        ArenaNode<T>* next = list.head->next;
+        list.alloc.delete_object(list.head);
+        list.head = next;
+    }
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+// Release: Tear the list down by releasing its monotonic arena, which must
+// back no other live objects. Node destructors only run when T needs them,
+// so for trivially destructible T this is O(1) in the list length.
+template <typename T>
+void release(ArenaList<T>& list, std::pmr::monotonic_buffer_resource& arena) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (ArenaNode<T>* curr = list.head; curr;) {
+            ArenaNode<T>* next = curr->next;
+            std::destroy_at(curr);
+            curr = next;
+        }
+    }
+    arena.release();
+    list.head = nullptr;
+    list.tail = nullptr;
+    list.size = 0;
+}
+
 int main() {
-    std::unique_ptr<Node> head = nullptr;
+    std::unique_ptr<Node<int>> head = nullptr;
     
     for (int idx = 1; idx <= 10; ++idx) {
         append(head, idx);
@@ -127,7 +419,7 @@ int main() {
     traverse(head);
     std::cout << "Count: " << count(head) << "\n\n";
     
-    Node* found = search(head, 5);
+    Node<int>* found = search(head, 5);
     if (found)
         std::cout << "Found value: " << found->data << "\n\n";
     else
@@ -148,6 +440,41 @@ int main() {
         std::cout << "Cleanup complete: head is nullptr.\n";
     else
         std::cout << "Cleanup failed: list still exists.\n";
+
+    // A list handle appends in O(1) and splices whole lists in O(1).
+    List<int> first;
+    List<int> second;
+    for (int idx = 1; idx <= 5; ++idx) {
+        push_back(first, idx);
+        push_back(second, 10 * idx);
+    }
+    splice(first, second);
+    std::cout << "\nList handle after splicing 10..50 onto 1..5:\n";
+    traverse(first);
+    std::cout << "Size: " << size(first) << ", spliced-from size: " << size(second) << "\n";
+
+    // Splicing a list onto itself is a no-op, and handles move without copying nodes.
+    splice(first, first);
+    List<int> moved = std::move(first);
+    std::cout << "Moved-to size after a self-splice: " << size(moved)
+              << ", moved-from size: " << size(first) << "\n";
+
+    // The same operations on a list whose nodes live in a monotonic arena.
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaList<int> list{.alloc = &arena};
+    for (int idx = 1; idx <= 10; ++idx) {
+        append(list, idx);
+    }
+    prepend(list, 0);
+    remove(list, 5);
+    reverse(list);
+    std::cout << "\nArena list after prepend 0, remove 5 and reverse:\n";
+    traverse(list);
+    std::cout << "Count: " << count(list) << "\n";
+
+    // Releasing the arena frees every node at once.
+    release(list, arena);
+    std::cout << "Arena released: " << (list.head ? "list still exists" : "head is nullptr") << "\n";
     
     return 0;
 }
@@ -1,114 +1,162 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-// Struct definition with a nested free_node_stack holding node arrays and free list information.
+#include "container_error.hpp"
+#include "node_pool.hpp"
+#include "node_pool_compact.hpp"
+#include "node_pool_scan.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Struct definition with a nested free_node_stack holding node arrays and their occupancy allocator.
+template <typename T, typename Index = int>
 struct LinkedList {
-    int head{-1}; // Head of the linked list (index of first node)
+    Index head{NULL_INDEX<Index>}; // Head of the linked list (index of first node)
     struct {
         struct {
-            std::unique_ptr<float[]> data{nullptr};    // Node values
-            std::unique_ptr<int[]> next{nullptr};        // Next pointers (indices)
+            std::unique_ptr<T[]> data{nullptr};     // Node values
+            std::unique_ptr<Index[]> next{nullptr}; // Next pointers (indices)
         } nodes;
-        std::unique_ptr<int[]> next_free{nullptr};       // Free list linking (free stack)
-        std::unique_ptr<bool[]> allocated{nullptr};      // Allocation flags
-        size_t size{0};                                  // Total number of nodes
-        int free_head{-1};                               // Head of the free list (index of first free node)
+        NodePool<Index> slots; // Occupancy bitmap allocator.
+        bool growable{true};   // Grow the pool when it runs out of free nodes
     } free_node_stack;
 };
 
 // Initialize the linked list with N nodes.
-// All nodes are initially free and linked as a free stack.
-void LinkedList_init(LinkedList &list, const size_t &N) {
-    list.head = -1;
-    list.free_node_stack.size = N;
-    list.free_node_stack.nodes.data = std::make_unique<float[]>(N);
-    list.free_node_stack.nodes.next = std::make_unique<int[]>(N);
-    list.free_node_stack.next_free = std::make_unique<int[]>(N);
-    list.free_node_stack.allocated = std::make_unique<bool[]>(N);
-    list.free_node_stack.free_head = 0; // Free list starts at index 0
-
-    // Assuming N is the total number of nodes.
-    for (size_t i = 0; i < N; ++i) 
-        list.free_node_stack.nodes.data[i] = 0.0f;
+// All nodes are initially free.
+template <typename T, typename Index>
+void LinkedList_init(LinkedList<T, Index> &list, const size_t &N) {
+    list.head = NULL_INDEX<Index>;
+    NodePool_init(list.free_node_stack.slots, N);
+    list.free_node_stack.nodes.data = make_payload_array<T>(N);
+    list.free_node_stack.nodes.next = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i)
-        list.free_node_stack.nodes.next[i] = -1;
+        list.free_node_stack.nodes.next[i] = NULL_INDEX<Index>;
+}
 
-    for (size_t i = 0; i < N; ++i)
-        list.free_node_stack.allocated[i] = false;
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool LinkedList_growPool(LinkedList<T, Index> &list) {
+    const size_t old_size = list.free_node_stack.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(list.free_node_stack.slots, new_size))
+        return false;
 
-    for (size_t i = 0; i < N; ++i)
-        list.free_node_stack.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.data.get() + old_size, data.get());
+    std::copy_n(list.free_node_stack.nodes.next.get(), old_size, next.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        next[i] = NULL_INDEX<Index>;
+    }
 
+    list.free_node_stack.nodes.data = std::move(data);
+    list.free_node_stack.nodes.next = std::move(next);
+    return true;
 }
 
-// Allocate a node by "popping" from the free stack.
+// Shrink the pool to new_size nodes, releasing the node arrays above it.
+// Every node at or above new_size must be free; returns false otherwise.
+template <typename T, typename Index>
+bool LinkedList_shrinkPool(LinkedList<T, Index> &list, const size_t new_size) {
+    if (!NodePool_shrink(list.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.data.get() + new_size, data.get());
+    std::copy_n(list.free_node_stack.nodes.next.get(), new_size, next.get());
+
+    list.free_node_stack.nodes.data = std::move(data);
+    list.free_node_stack.nodes.next = std::move(next);
+    return true;
+}
+
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
 // Sets the node's value and marks it as allocated.
 // Returns the allocated node index via node_idx.
-void LinkedList_allocateNode(LinkedList &list, const float &value, int &node_idx) {
-    node_idx = -1;
-    if (list.free_node_stack.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void LinkedList_allocateNode(LinkedList<T, Index> &list, const T &value, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(list.free_node_stack.slots) &&
+        !(list.free_node_stack.growable && LinkedList_growPool(list))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // Pop: take the node at free_head.
-    node_idx = list.free_node_stack.free_head;
-    // Update free_head to the next free node.
-    list.free_node_stack.free_head = list.free_node_stack.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(list.free_node_stack.slots, node_idx);
 
     // Initialize the allocated node.
     list.free_node_stack.nodes.data[node_idx] = value;
-    list.free_node_stack.nodes.next[node_idx] = -1;
-    list.free_node_stack.allocated[node_idx] = true;
+    list.free_node_stack.nodes.next[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by "pushing" it back onto the free stack.
+// Deallocate a node by returning it to the pool.
 // Checks for double deallocation.
-void LinkedList_deallocateNode(LinkedList &list, const size_t &idx) {
-    if (idx >= list.free_node_stack.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+template <typename T, typename Index>
+void LinkedList_deallocateNode(LinkedList<T, Index> &list, const size_t &idx) {
+    if (idx >= list.free_node_stack.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
     
-    if (!list.free_node_stack.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(list.free_node_stack.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     
     // Reset node's value and next pointer.
-    list.free_node_stack.nodes.data[idx] = 0.0f;
-    list.free_node_stack.nodes.next[idx] = -1;
-    list.free_node_stack.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        list.free_node_stack.nodes.data[idx] = T{}; // Release resources held by the payload.
+    list.free_node_stack.nodes.next[idx] = NULL_INDEX<Index>;
 
-    // Push: add this node back to the free stack.
-    list.free_node_stack.next_free[idx] = list.free_node_stack.free_head;
-    list.free_node_stack.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(list.free_node_stack.slots, idx);
 }
 
 // Append a value to the end of the linked list.
-void LinkedList_append(LinkedList &list, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void LinkedList_append(LinkedList<T, Index> &list, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     LinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
-    if (list.head == -1) {
+    if (list.head == NULL_INDEX<Index>) {
         // If the list is empty, the new node becomes the head.
         list.head = new_node;
     } else {
-        int current = list.head;
+        Index current = list.head;
         // Traverse until the end of the list.
-        while (list.free_node_stack.nodes.next[current] != -1)
+        while (list.free_node_stack.nodes.next[current] != NULL_INDEX<Index>)
             current = list.free_node_stack.nodes.next[current];
         list.free_node_stack.nodes.next[current] = new_node;
     }
 }
 
 // Prepend a value to the beginning of the linked list.
-void LinkedList_prepend(LinkedList &list, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void LinkedList_prepend(LinkedList<T, Index> &list, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     LinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
     // The new node points to the current head.
@@ -117,15 +165,16 @@ void LinkedList_prepend(LinkedList &list, const float &value) {
 }
 
 // Insert a value after the node at the specified index.
-void LinkedList_insertAfter(LinkedList &list, int node_idx, const float &value) {
-    if (node_idx < 0 || static_cast<size_t>(node_idx) >= list.free_node_stack.size ||
-        !list.free_node_stack.allocated[node_idx]) {
-        std::cerr << "Error: Invalid node index for insertion." << std::endl;
+template <typename T, typename Index>
+void LinkedList_insertAfter(LinkedList<T, Index> &list, Index node_idx, const T &value) {
+    if (static_cast<size_t>(node_idx) >= list.free_node_stack.slots.size ||
+        !NodePool_isAllocated(list.free_node_stack.slots, node_idx)) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Invalid node index for insertion.");
         return;
     }
-    int new_node = -1;
+    Index new_node = NULL_INDEX<Index>;
     LinkedList_allocateNode(list, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
     // Insert the new node after node_idx.
@@ -134,61 +183,448 @@ void LinkedList_insertAfter(LinkedList &list, int node_idx, const float &value)
 }
 
 // Search for the first node containing the specified value.
-// Returns the node index if found, otherwise returns -1.
-void LinkedList_search(LinkedList &list, const float &value, int &result) {
-    int current = list.head;
-    while (current != -1) {
+// Returns the node index if found, otherwise returns NULL_INDEX.
+template <typename T, typename Index>
+void LinkedList_search(LinkedList<T, Index> &list, const T &value, Index &result) {
+    Index current = list.head;
+    while (current != NULL_INDEX<Index>) {
         if (list.free_node_stack.nodes.data[current] == value) {
             result = current;
             return;
         }
         current = list.free_node_stack.nodes.next[current];
     }
-    result = -1;
+    result = NULL_INDEX<Index>;
 }
 
 
 // Delete the first node found that contains the specified value.
-void LinkedList_delete(LinkedList &list, const float &value) {
-    int current = list.head;
-    int prev = -1;
+template <typename T, typename Index>
+void LinkedList_delete(LinkedList<T, Index> &list, const T &value) {
+    Index current = list.head;
+    Index prev = NULL_INDEX<Index>;
     // Traverse the list to locate the node with the given value.
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         if (list.free_node_stack.nodes.data[current] == value)
             break;
         prev = current;
         current = list.free_node_stack.nodes.next[current];
     }
-    if (current == -1) {
-        std::cerr << "Value " << value << " not found." << std::endl;
+    if (current == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Value " << value << " not found.");
         return;
     }
     // Remove the node from the list.
-    if (prev == -1) {
+    if (prev == NULL_INDEX<Index>) {
         // Deleting the head.
         list.head = list.free_node_stack.nodes.next[current];
     } else {
         list.free_node_stack.nodes.next[prev] = list.free_node_stack.nodes.next[current];
     }
-    // Deallocate the node (push it back onto the free stack).
+    // Deallocate the node (return it to the pool).
     LinkedList_deallocateNode(list, current);
 }
 
+// Check whether any node holds the specified value, in any order.
+// Streams the payload array with SIMD compares instead of following next links.
+template <typename T, typename Index>
+bool LinkedList_contains(const LinkedList<T, Index> &list, const T &value) {
+    return NodePool_contains(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), value);
+}
+
+// Count the nodes whose value satisfies compare(value, threshold), for
+// example LinkedList_countIf(list, std::greater<>{}, t) counts values above t.
+// Standard comparators on float and int32 payloads are evaluated with SIMD.
+template <typename T, typename Index, typename Compare>
+size_t LinkedList_countIf(const LinkedList<T, Index> &list, const Compare &compare, const T &threshold) {
+    return NodePool_countIf(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), compare, threshold);
+}
+
+// Collect the indices of the nodes whose value satisfies compare(value, threshold).
+// Indices come out in pool order, not list order.
+template <typename T, typename Index, typename Compare>
+void LinkedList_findAll(const LinkedList<T, Index> &list, const Compare &compare, const T &threshold, std::vector<Index> &result) {
+    result.clear();
+    NodePool_findAll(list.free_node_stack.slots, list.free_node_stack.nodes.data.get(), compare, threshold, result);
+}
+
+// Run one slice of an incremental compaction, handling at most budget nodes.
+// Renumbers the live nodes so that traversal from the head is one
+// sequential sweep through memory, and leaves the free nodes as one
+// contiguous tail. Other operations may run between slices. Start with a
+// default-constructed state; returns true once the pass is complete.
+template <typename T, typename Index>
+bool LinkedList_compactStep(LinkedList<T, Index> &list, NodePoolCompaction<Index> &state, const size_t budget) {
+    auto make_links = [&list] {
+        return NodePoolLinks<T, Index>{list.free_node_stack.nodes.data.get(), list.free_node_stack.nodes.next.get(), nullptr,
+                                       &list.head, nullptr, false};
+    };
+    auto grow = [&list] { return list.free_node_stack.growable && LinkedList_growPool(list); };
+    auto shrink = [&list](const size_t new_size) { LinkedList_shrinkPool(list, new_size); };
+    return NodePool_compactStep(list.free_node_stack.slots, state, budget, make_links, grow, shrink);
+}
+
+// Compact the linked list in a single pass.
+template <typename T, typename Index>
+void LinkedList_compact(LinkedList<T, Index> &list) {
+    NodePoolCompaction<Index> state;
+    LinkedList_compactStep(list, state, std::numeric_limits<size_t>::max());
+}
+
+// Fraction of links that do not lead to the adjacent node slot (0: fully sequential).
+template <typename T, typename Index>
+double LinkedList_fragmentation(const LinkedList<T, Index> &list) {
+    return NodePool_fragmentation(list.free_node_stack.nodes.next.get(), list.head, false);
+}
+
 // Print the values in the linked list.
-void LinkedList_print(const LinkedList &list) {
-    int current = list.head;
+template <typename T, typename Index>
+void LinkedList_print(const LinkedList<T, Index> &list) {
+    Index current = list.head;
     std::cout << "LinkedList: ";
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         std::cout << list.free_node_stack.nodes.data[current] << " ";
         current = list.free_node_stack.nodes.next[current];
     }
     std::cout << std::endl;
 }
 
+// Number of elements in one unrolled list chunk: as many as fit a cache line.
+template <typename T>
+constexpr int UnrolledList_capacity = static_cast<int>(std::bit_floor(std::max<size_t>(1, 64 / sizeof(T))));
+
+// Elements of one unrolled list node, aligned to a cache line.
+template <typename T>
+struct alignas(64) UnrolledChunk {
+    T items[UnrolledList_capacity<T>];
+};
+
+// Unrolled linked list using a free-node pool for storage.
+// Each pool node holds a chunk of up to UnrolledList_capacity<T> elements
+// in order plus a count, so a traversal takes one next hop per cache line
+// instead of one per element. Inserting into a full chunk splits it in
+// half; a delete that leaves a chunk under half full refills it from, or
+// merges it with, the next chunk. Elements are addressed by node index and
+// offset within the node.
+template <typename T, typename Index = int>
+struct UnrolledList {
+    Index head{NULL_INDEX<Index>}; // Index of the first node.
+    Index tail{NULL_INDEX<Index>}; // Index of the last node.
+    size_t size{0};                // Number of elements.
+
+    // Free-node pool holding node arrays and their occupancy allocator.
+    struct {
+        std::unique_ptr<UnrolledChunk<T>[]> chunks{nullptr}; // Node elements.
+        std::unique_ptr<std::uint8_t[]> count{nullptr};      // Number of elements in each node.
+        std::unique_ptr<Index[]> next{nullptr};              // Next pointers (indices).
+        NodePool<Index> slots;                               // Occupancy bitmap allocator.
+        bool growable{true};                                 // Grow the pool when it runs out of free nodes.
+    } pool;
+};
+
+// Offset of the first of the count elements in items equal to value, or -1.
+// Chunks are value-initialized, so float and 32-bit integer chunks are
+// compared whole with SIMD and the match mask is cut to count.
+template <typename T>
+int UnrolledList_find(const UnrolledChunk<T> &chunk, const int count, const T &value) {
+    constexpr int K = UnrolledList_capacity<T>;
+    [[maybe_unused]] constexpr bool simd_float = std::is_same_v<T, float>;
+    [[maybe_unused]] constexpr bool simd_int = std::is_integral_v<T> && sizeof(T) == 4;
+    [[maybe_unused]] const std::uint64_t live = (count == 64) ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+#if defined(__AVX2__)
+    if constexpr (simd_float || simd_int) {
+        std::uint64_t mask = 0;
+        for (int i = 0; i < K; i += 8) {
+            unsigned block;
+            if constexpr (simd_float) {
+                __m256 lanes = _mm256_load_ps(chunk.items + i);
+                block = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lanes, _mm256_set1_ps(value), _CMP_EQ_OQ)));
+            } else {
+                __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i *>(chunk.items + i));
+                __m256i eq = _mm256_cmpeq_epi32(lanes, _mm256_set1_epi32(static_cast<int>(value)));
+                block = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+            }
+            mask |= std::uint64_t{block} << i;
+        }
+        mask &= live;
+        return mask ? std::countr_zero(mask) : -1;
+    }
+#elif defined(__SSE2__)
+    if constexpr (simd_float || simd_int) {
+        std::uint64_t mask = 0;
+        for (int i = 0; i < K; i += 4) {
+            unsigned block;
+            if constexpr (simd_float) {
+                __m128 lanes = _mm_load_ps(chunk.items + i);
+                block = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(lanes, _mm_set1_ps(value))));
+            } else {
+                __m128i lanes = _mm_load_si128(reinterpret_cast<const __m128i *>(chunk.items + i));
+                __m128i eq = _mm_cmpeq_epi32(lanes, _mm_set1_epi32(static_cast<int>(value)));
+                block = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+            }
+            mask |= std::uint64_t{block} << i;
+        }
+        mask &= live;
+        return mask ? std::countr_zero(mask) : -1;
+    }
+#endif
+    for (int i = 0; i < count; ++i)
+        if (chunk.items[i] == value)
+            return i;
+    return -1;
+}
+
+// Initialize the unrolled list with N nodes.
+// All nodes are initially free.
+template <typename T, typename Index>
+void UnrolledList_init(UnrolledList<T, Index> &list, const size_t &N) {
+    list.head = NULL_INDEX<Index>;
+    list.tail = NULL_INDEX<Index>;
+    list.size = 0;
+    NodePool_init(list.pool.slots, N);
+    list.pool.chunks = std::make_unique<UnrolledChunk<T>[]>(N);
+    list.pool.count = std::make_unique<std::uint8_t[]>(N);
+    list.pool.next = std::make_unique<Index[]>(N);
+
+    for (size_t i = 0; i < N; ++i)
+        list.pool.next[i] = NULL_INDEX<Index>;
+}
+
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool UnrolledList_growPool(UnrolledList<T, Index> &list) {
+    const size_t old_size = list.pool.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(list.pool.slots, new_size))
+        return false;
+
+    auto chunks = std::make_unique<UnrolledChunk<T>[]>(new_size);
+    auto count = std::make_unique<std::uint8_t[]>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(list.pool.chunks.get(), list.pool.chunks.get() + old_size, chunks.get());
+    std::copy_n(list.pool.count.get(), old_size, count.get());
+    std::copy_n(list.pool.next.get(), old_size, next.get());
+
+    for (size_t i = old_size; i < new_size; ++i)
+        next[i] = NULL_INDEX<Index>;
+
+    list.pool.chunks = std::move(chunks);
+    list.pool.count = std::move(count);
+    list.pool.next = std::move(next);
+    return true;
+}
+
+// Allocate the lowest free node from the pool as an empty chunk.
+// Grows the pool first if every node is in use and the pool is growable.
+// Returns the allocated node index via node_idx.
+template <typename T, typename Index>
+void UnrolledList_allocateNode(UnrolledList<T, Index> &list, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(list.pool.slots) &&
+        !(list.pool.growable && UnrolledList_growPool(list))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
+        return;
+    }
+    NodePool_allocate(list.pool.slots, node_idx);
+    list.pool.count[node_idx] = 0;
+    list.pool.next[node_idx] = NULL_INDEX<Index>;
+}
+
+// Deallocate a node by returning it to the pool.
+// Checks for double deallocation.
+template <typename T, typename Index>
+void UnrolledList_deallocateNode(UnrolledList<T, Index> &list, const size_t &idx) {
+    if (idx >= list.pool.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
+        return;
+    }
+    if (!NodePool_isAllocated(list.pool.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
+        return;
+    }
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        list.pool.chunks[idx] = UnrolledChunk<T>{}; // Release resources held by the elements.
+    list.pool.count[idx] = 0;
+    list.pool.next[idx] = NULL_INDEX<Index>;
+    NodePool_free(list.pool.slots, idx);
+}
+
+// Allocate an empty node and link it after node_idx (or as the only node if node_idx is NULL_INDEX).
+// Returns the new node index via new_node, or NULL_INDEX if the pool is exhausted.
+template <typename T, typename Index>
+void UnrolledList_linkNodeAfter(UnrolledList<T, Index> &list, const Index node_idx, Index &new_node) {
+    UnrolledList_allocateNode(list, new_node);
+    if (new_node == NULL_INDEX<Index>)
+        return;
+    if (node_idx == NULL_INDEX<Index>) {
+        list.head = new_node;
+    } else {
+        list.pool.next[new_node] = list.pool.next[node_idx];
+        list.pool.next[node_idx] = new_node;
+    }
+    if (list.tail == node_idx)
+        list.tail = new_node;
+}
+
+// Insert value at offset pos of node node_idx (0 <= pos <= its count).
+// A full node is split in half first, or, when inserting at its end,
+// the value starts a new node after it.
+template <typename T, typename Index>
+void UnrolledList_insertAt(UnrolledList<T, Index> &list, Index node_idx, int pos, const T &value) {
+    constexpr int K = UnrolledList_capacity<T>;
+    if (list.pool.count[node_idx] == K) {
+        Index new_node = NULL_INDEX<Index>;
+        UnrolledList_linkNodeAfter(list, node_idx, new_node);
+        if (new_node == NULL_INDEX<Index>)
+            return;
+        if (pos < K) {
+            // Move the upper half of the chunk into the new node.
+            constexpr int half = K / 2;
+            std::move(list.pool.chunks[node_idx].items + half, list.pool.chunks[node_idx].items + K,
+                      list.pool.chunks[new_node].items);
+            list.pool.count[node_idx] = half;
+            list.pool.count[new_node] = K - half;
+            if (pos <= half)
+                new_node = node_idx;
+            else
+                pos -= half;
+        } else {
+            pos = 0;
+        }
+        node_idx = new_node;
+    }
+    T *items = list.pool.chunks[node_idx].items;
+    const int count = list.pool.count[node_idx];
+    std::move_backward(items + pos, items + count, items + count + 1);
+    items[pos] = value;
+    ++list.pool.count[node_idx];
+    ++list.size;
+}
+
+// Append a value to the end of the unrolled list.
+template <typename T, typename Index>
+void UnrolledList_append(UnrolledList<T, Index> &list, const T &value) {
+    if (list.tail == NULL_INDEX<Index>) {
+        Index new_node = NULL_INDEX<Index>;
+        UnrolledList_linkNodeAfter(list, NULL_INDEX<Index>, new_node);
+        if (new_node == NULL_INDEX<Index>)
+            return;
+    }
+    UnrolledList_insertAt(list, list.tail, list.pool.count[list.tail], value);
+}
+
+// Prepend a value to the beginning of the unrolled list.
+template <typename T, typename Index>
+void UnrolledList_prepend(UnrolledList<T, Index> &list, const T &value) {
+    if (list.head == NULL_INDEX<Index>) {
+        UnrolledList_append(list, value);
+        return;
+    }
+    UnrolledList_insertAt(list, list.head, 0, value);
+}
+
+// Insert a value after the element at offset of node node_idx.
+template <typename T, typename Index>
+void UnrolledList_insertAfter(UnrolledList<T, Index> &list, Index node_idx, const int offset, const T &value) {
+    if (static_cast<size_t>(node_idx) >= list.pool.slots.size ||
+        !NodePool_isAllocated(list.pool.slots, node_idx) ||
+        offset < 0 || offset >= list.pool.count[node_idx]) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Invalid element position for insertion.");
+        return;
+    }
+    UnrolledList_insertAt(list, node_idx, offset + 1, value);
+}
+
+// Search for the first element equal to the specified value.
+// Returns its node index and offset, or NULL_INDEX and -1 if not found.
+template <typename T, typename Index>
+void UnrolledList_search(const UnrolledList<T, Index> &list, const T &value, Index &node_idx, int &offset) {
+    for (Index current = list.head; current != NULL_INDEX<Index>; current = list.pool.next[current]) {
+        offset = UnrolledList_find(list.pool.chunks[current], list.pool.count[current], value);
+        if (offset >= 0) {
+            node_idx = current;
+            return;
+        }
+    }
+    node_idx = NULL_INDEX<Index>;
+    offset = -1;
+}
+
+// Delete the first element equal to the specified value.
+// A node left under half full takes elements from the next node, or is
+// merged with it when both fit one chunk; an emptied node is unlinked.
+template <typename T, typename Index>
+void UnrolledList_delete(UnrolledList<T, Index> &list, const T &value) {
+    constexpr int K = UnrolledList_capacity<T>;
+    Index current = list.head;
+    Index prev = NULL_INDEX<Index>;
+    int offset = -1;
+    // Traverse the list to locate the node holding the value.
+    while (current != NULL_INDEX<Index>) {
+        offset = UnrolledList_find(list.pool.chunks[current], list.pool.count[current], value);
+        if (offset >= 0)
+            break;
+        prev = current;
+        current = list.pool.next[current];
+    }
+    if (current == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::NotFound, "Value " << value << " not found.");
+        return;
+    }
+    T *items = list.pool.chunks[current].items;
+    int count = list.pool.count[current];
+    std::move(items + offset + 1, items + count, items + offset);
+    list.pool.count[current] = static_cast<std::uint8_t>(--count);
+    --list.size;
+
+    const Index next = list.pool.next[current];
+    if (count == 0) {
+        // Unlink the emptied node.
+        if (prev == NULL_INDEX<Index>)
+            list.head = next;
+        else
+            list.pool.next[prev] = next;
+        if (list.tail == current)
+            list.tail = prev;
+        UnrolledList_deallocateNode(list, current);
+    } else if (count < K / 2 && next != NULL_INDEX<Index>) {
+        T *next_items = list.pool.chunks[next].items;
+        const int next_count = list.pool.count[next];
+        // Merge the next node in if both fit, otherwise even the two out.
+        const int moved = (count + next_count <= K) ? next_count : (next_count - count) / 2;
+        std::move(next_items, next_items + moved, items + count);
+        std::move(next_items + moved, next_items + next_count, next_items);
+        list.pool.count[current] = static_cast<std::uint8_t>(count + moved);
+        list.pool.count[next] = static_cast<std::uint8_t>(next_count - moved);
+        if (moved == next_count) {
+            list.pool.next[current] = list.pool.next[next];
+            if (list.tail == next)
+                list.tail = current;
+            UnrolledList_deallocateNode(list, next);
+        }
+    }
+}
+
+// Print the values in the unrolled list, one bracketed group per node.
+template <typename T, typename Index>
+void UnrolledList_print(const UnrolledList<T, Index> &list) {
+    std::cout << "UnrolledList: ";
+    for (Index current = list.head; current != NULL_INDEX<Index>; current = list.pool.next[current]) {
+        std::cout << "[ ";
+        for (int i = 0; i < list.pool.count[current]; ++i)
+            std::cout << list.pool.chunks[current].items[i] << " ";
+        std::cout << "] ";
+    }
+    std::cout << std::endl;
+}
+
 // Demonstration of linked list operations.
 int main() {
     constexpr size_t N = 10;
-    LinkedList list;
+    LinkedList<float> list;
     
     // Initialize the linked list with N nodes.
     LinkedList_init(list, N);
@@ -214,5 +650,52 @@ int main() {
     LinkedList_delete(list, 2.2f);
     LinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3
     
+    // Append past the initial capacity; the pool grows on demand.
+    for (int i = 0; i < static_cast<int>(N); ++i)
+        LinkedList_append(list, static_cast<float>(10 + i));
+    std::cout << "Pool size after growth: " << list.free_node_stack.slots.size << std::endl;
+    LinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3 10 ... 19
+    
+    // Order-independent membership and filter queries scan the node pool directly.
+    std::cout << "Contains 1.5: " << LinkedList_contains(list, 1.5f)
+              << ", contains 2.2: " << LinkedList_contains(list, 2.2f) << std::endl;  // Expected: 1, 0
+    std::cout << "Values above 12: " << LinkedList_countIf(list, std::greater<>{}, 12.0f) << std::endl;  // Expected: 7
+    std::vector<int> small;
+    LinkedList_findAll(list, std::less<>{}, 2.0f, small);
+    std::cout << "Nodes holding values below 2:";
+    for (int idx : small)
+        std::cout << " " << idx << "=" << list.free_node_stack.nodes.data[idx];
+    std::cout << std::endl;  // Expected: the nodes holding 0, 1.1 and 1.5
+    
+    // Compaction renumbers the nodes in traversal order, here in slices of at most 4 nodes.
+    std::cout << "Fragmentation before compaction: " << LinkedList_fragmentation(list) << std::endl;
+    NodePoolCompaction<int> compaction;
+    int slices = 1;
+    while (!LinkedList_compactStep(list, compaction, 4))
+        ++slices;
+    std::cout << "Fragmentation after " << slices << " slices: " << LinkedList_fragmentation(list) << std::endl;  // Expected: 0
+    LinkedList_print(list);  // Expected: 0.0 1.1 1.5 3.3 10 ... 19
+    
+    // The unrolled list packs up to 16 floats into each cache-line node.
+    UnrolledList<float> unrolled;
+    UnrolledList_init(unrolled, 2);
+    for (int i = 0; i < 40; ++i)
+        UnrolledList_append(unrolled, static_cast<float>(i));
+    UnrolledList_print(unrolled);  // Expected: [ 0 ... 15 ] [ 16 ... 31 ] [ 32 ... 39 ]
+
+    // Inserting into a full node splits it in half.
+    int node;
+    int offset;
+    UnrolledList_search(unrolled, 20.0f, node, offset);
+    if (node != -1)
+        UnrolledList_insertAfter(unrolled, node, offset, 20.5f);
+    UnrolledList_print(unrolled);  // Expected: [ 0 ... 15 ] [ 16 ... 20 20.5 21 ... 23 ] [ 24 ... 31 ] [ 32 ... 39 ]
+
+    // Deleting below half full refills the node from the next one, or merges the two.
+    for (int i = 16; i < 24; ++i)
+        UnrolledList_delete(unrolled, static_cast<float>(i));
+    UnrolledList_print(unrolled);  // Expected: [ 0 ... 15 ] [ 20.5 24 ... 31 ] [ 32 ... 39 ]
+    std::cout << "Unrolled size: " << unrolled.size << std::endl;  // Expected: 33
+    
     return 0;
 }
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "container_error.hpp"
+
+// Sentinel index meaning "no node": -1 for signed index types, the maximum value for unsigned ones.
+template <typename Index>
+constexpr Index NULL_INDEX = static_cast<Index>(-1);
+
+// Allocate a node payload array. Trivially copyable payloads skip
+// value-initialization, since a free node's payload is never read.
+template <typename T>
+std::unique_ptr<T[]> make_payload_array(const size_t n) {
+    if constexpr (std::is_trivially_copyable_v<T>)
+        return std::make_unique_for_overwrite<T[]>(n);
+    else
+        return std::make_unique<T[]>(n);
+}
+
+// Number of bitmap levels needed to cover every index of any supported index type.
+constexpr int NODE_POOL_MAX_LEVELS = 6;
+
+// Number of free nodes the pool keeps in its cache, in front of the bitmaps.
+constexpr size_t NODE_POOL_CACHE_SIZE = 64;
+
+// Slot allocator shared by the pool-based containers.
+// Free nodes are tracked as a hierarchy of bitmaps: bit i of level 0 is set
+// while node i is free, and bit w of level k + 1 is set while word w of
+// level k is nonzero. The top level is a single word, so finding the
+// lowest free node is one count-trailing-zeros per level (at most six for
+// 64-bit indices).
+// Single-node allocation and free go through a small cache of free nodes
+// that are held out of the bitmaps, so the common case is a push or pop.
+// An empty cache is refilled with the lowest free nodes, a batch at a time;
+// a full cache returns its oldest half to the bitmaps. Recently freed nodes
+// are therefore reused first, and otherwise allocation is lowest index
+// first, which keeps live nodes packed at the front of the pool.
+// The container owns the node arrays and grows them alongside the pool.
+template <typename Index = int>
+struct NodePool {
+    std::unique_ptr<std::uint64_t[]> free_bits[NODE_POOL_MAX_LEVELS]; // Bitmap levels, level 0 first.
+    std::unique_ptr<std::uint64_t[]> cached_bits;                    // Bit i set while node i is in the cache.
+    Index cache[NODE_POOL_CACHE_SIZE]{};                             // Cached free nodes, next to allocate last.
+    size_t cached{0};                                                // Number of nodes in the cache.
+    int levels{0};                                                   // Number of levels in use.
+    size_t size{0};                                                  // Total number of nodes.
+    size_t count{0};                                                 // Number of allocated nodes.
+};
+
+// Number of 64-bit words needed for n bits.
+constexpr size_t NodePool_words(const size_t n) {
+    return (n + 63) / 64;
+}
+
+// Build the bitmap levels for N nodes, with level 0 taken from free_bits
+// (which must hold NodePool_words(N) words). The cache bitmap is resized
+// to match; cached nodes must all be below N.
+template <typename Index>
+void NodePool_build(NodePool<Index> &pool, std::unique_ptr<std::uint64_t[]> free_bits, const size_t N) {
+    auto cached_bits = std::make_unique<std::uint64_t[]>(NodePool_words(N));
+    if (pool.cached_bits)
+        std::copy_n(pool.cached_bits.get(), std::min(NodePool_words(pool.size), NodePool_words(N)), cached_bits.get());
+    pool.cached_bits = std::move(cached_bits);
+    for (int k = 0; k < NODE_POOL_MAX_LEVELS; ++k)
+        pool.free_bits[k].reset();
+    pool.free_bits[0] = std::move(free_bits);
+    pool.levels = 1;
+    size_t words = NodePool_words(N);
+    while (words > 1) {
+        const size_t parent_words = NodePool_words(words);
+        auto parent = std::make_unique<std::uint64_t[]>(parent_words);
+        for (size_t w = 0; w < words; ++w)
+            if (pool.free_bits[pool.levels - 1][w] != 0)
+                parent[w / 64] |= std::uint64_t{1} << (w % 64);
+        pool.free_bits[pool.levels++] = std::move(parent);
+        words = parent_words;
+    }
+    // Keep a top word even for an empty pool, so the full check needs no size test.
+    if (N == 0)
+        pool.free_bits[0] = std::make_unique<std::uint64_t[]>(1);
+    pool.size = N;
+}
+
+// Initialize the pool with N free nodes.
+template <typename Index>
+void NodePool_init(NodePool<Index> &pool, const size_t N) {
+    auto free_bits = std::make_unique<std::uint64_t[]>(NodePool_words(N));
+    for (size_t w = 0; w < N / 64; ++w)
+        free_bits[w] = ~std::uint64_t{0};
+    if (N % 64 != 0)
+        free_bits[N / 64] = (std::uint64_t{1} << (N % 64)) - 1;
+    pool.count = 0;
+    pool.cached = 0;
+    pool.cached_bits.reset();
+    NodePool_build(pool, std::move(free_bits), N);
+}
+
+// Grow the pool to new_size nodes; the added nodes are free.
+// Existing indices are unchanged. Returns false if new_size does not fit
+// the index type (the largest unsigned value is reserved for NULL_INDEX).
+template <typename Index>
+bool NodePool_grow(NodePool<Index> &pool, const size_t new_size) {
+    if (new_size > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+        CONTAINER_ERROR(ContainerError::Full, "Node pool cannot grow beyond the index range.");
+        return false;
+    }
+    auto free_bits = std::make_unique<std::uint64_t[]>(NodePool_words(new_size));
+    std::copy_n(pool.free_bits[0].get(), NodePool_words(pool.size), free_bits.get());
+    for (size_t i = pool.size; i < new_size; ++i)
+        free_bits[i / 64] |= std::uint64_t{1} << (i % 64);
+    NodePool_build(pool, std::move(free_bits), new_size);
+    return true;
+}
+
+// Check whether every node is allocated.
+template <typename Index>
+bool NodePool_full(const NodePool<Index> &pool) {
+    return pool.cached == 0 && pool.free_bits[pool.levels - 1][0] == 0;
+}
+
+// Bit i set while node 64 * w + i is free, in the bitmaps or in the cache.
+template <typename Index>
+std::uint64_t NodePool_freeWord(const NodePool<Index> &pool, const size_t w) {
+    return pool.free_bits[0][w] | pool.cached_bits[w];
+}
+
+// Check whether node idx is currently allocated.
+template <typename Index>
+bool NodePool_isAllocated(const NodePool<Index> &pool, const size_t idx) {
+    return idx < pool.size && ((NodePool_freeWord(pool, idx / 64) >> (idx % 64)) & 1) == 0;
+}
+
+// Index of the level-0 word holding the lowest free node. The pool must not be full.
+template <typename Index>
+size_t NodePool_firstFreeWord(const NodePool<Index> &pool) {
+    size_t w = 0;
+    for (int k = pool.levels - 1; k > 0; --k)
+        w = w * 64 + static_cast<size_t>(std::countr_zero(pool.free_bits[k][w]));
+    return w;
+}
+
+// Clear the summary bits above level-0 word w after it became zero.
+template <typename Index>
+void NodePool_markWordFull(NodePool<Index> &pool, size_t w) {
+    for (int k = 1; k < pool.levels; ++k) {
+        pool.free_bits[k][w / 64] &= ~(std::uint64_t{1} << (w % 64));
+        w /= 64;
+        if (pool.free_bits[k][w] != 0)
+            break;
+    }
+}
+
+// Mark the nodes in mask free in level-0 word w, and the word in the levels above.
+template <typename Index>
+void NodePool_releaseWord(NodePool<Index> &pool, size_t w, const std::uint64_t mask) {
+    const bool was_empty = pool.free_bits[0][w] == 0;
+    pool.free_bits[0][w] |= mask;
+    if (!was_empty)
+        return;
+    // Set the bit on each level above until one already had a free node below it.
+    for (int k = 1; k < pool.levels; ++k) {
+        const size_t bit = w % 64;
+        w /= 64;
+        const bool word_was_empty = pool.free_bits[k][w] == 0;
+        pool.free_bits[k][w] |= std::uint64_t{1} << bit;
+        if (!word_was_empty)
+            break;
+    }
+}
+
+// Call f(w, mask) for each run of consecutive indices that share bitmap word
+// w, with mask holding their bits, so each word is updated once per run.
+template <typename Index, typename F>
+void NodePool_forEachWord(const Index *indices, const size_t n, F f) {
+    for (size_t i = 0; i < n;) {
+        const size_t w = static_cast<size_t>(indices[i]) / 64;
+        std::uint64_t mask = 0;
+        for (; i < n && static_cast<size_t>(indices[i]) / 64 == w; ++i)
+            mask |= std::uint64_t{1} << (static_cast<size_t>(indices[i]) % 64);
+        f(w, mask);
+    }
+}
+
+// Allocate up to n nodes, lowest indices first, writing their indices to out.
+// Free nodes are taken from the bitmaps a whole word at a time; the cache
+// is left alone. Returns the number of nodes allocated.
+template <typename Index>
+size_t NodePool_allocateN(NodePool<Index> &pool, const size_t n, Index *out) {
+    size_t got = 0;
+    while (got < n && pool.free_bits[pool.levels - 1][0] != 0) {
+        const size_t w = NodePool_firstFreeWord(pool);
+        std::uint64_t &bits = pool.free_bits[0][w];
+        while (bits != 0 && got < n) {
+            out[got++] = static_cast<Index>(w * 64 + static_cast<size_t>(std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+        if (bits == 0)
+            NodePool_markWordFull(pool, w);
+    }
+    pool.count += got;
+    return got;
+}
+
+// Refill an empty cache with up to half a cache of the lowest free nodes,
+// queued so that the lowest is allocated first. Returns the number added.
+template <typename Index>
+size_t NodePool_refillCache(NodePool<Index> &pool) {
+    const size_t got = NodePool_allocateN(pool, NODE_POOL_CACHE_SIZE / 2, pool.cache);
+    pool.count -= got;
+    NodePool_forEachWord(pool.cache, got, [&pool](const size_t w, const std::uint64_t mask) { pool.cached_bits[w] |= mask; });
+    std::reverse(pool.cache, pool.cache + got);
+    pool.cached = got;
+    return got;
+}
+
+// Allocate a free node into node_idx: the most recently freed one still in
+// the cache, or else the lowest free node.
+// Returns false (and sets node_idx to NULL_INDEX) if the pool is full.
+template <typename Index>
+bool NodePool_allocate(NodePool<Index> &pool, Index &node_idx) {
+    if (pool.cached == 0 && NodePool_refillCache(pool) == 0) {
+        node_idx = NULL_INDEX<Index>;
+        return false;
+    }
+    const Index idx = pool.cache[--pool.cached];
+    pool.cached_bits[idx / 64] &= ~(std::uint64_t{1} << (idx % 64));
+    ++pool.count;
+    node_idx = idx;
+    return true;
+}
+
+// Allocate the specific node idx. Returns false if it is out of range or already allocated.
+template <typename Index>
+bool NodePool_allocateAt(NodePool<Index> &pool, const size_t idx) {
+    if (idx >= pool.size || NodePool_isAllocated(pool, idx))
+        return false;
+    if ((pool.cached_bits[idx / 64] >> (idx % 64)) & 1) {
+        // Take it out of the cache; the order of the other cached nodes does not matter.
+        Index *it = std::find(pool.cache, pool.cache + pool.cached, static_cast<Index>(idx));
+        *it = pool.cache[--pool.cached];
+        pool.cached_bits[idx / 64] &= ~(std::uint64_t{1} << (idx % 64));
+        ++pool.count;
+        return true;
+    }
+    std::uint64_t &bits = pool.free_bits[0][idx / 64];
+    bits &= ~(std::uint64_t{1} << (idx % 64));
+    if (bits == 0)
+        NodePool_markWordFull(pool, idx / 64);
+    ++pool.count;
+    return true;
+}
+
+// Lowest free node index at or after from, or pool.size if there is none.
+// Climbs the bitmap levels until a word has a free bit past the start, then descends.
+// Nodes in the cache are not reported; flush it first to include them.
+template <typename Index>
+size_t NodePool_nextFree(const NodePool<Index> &pool, const size_t from) {
+    size_t pos = from;
+    size_t bits_at_level = pool.size;
+    int k = 0;
+    while (true) {
+        if (pos >= bits_at_level)
+            return pool.size;
+        const std::uint64_t bits = pool.free_bits[k][pos / 64] & (~std::uint64_t{0} << (pos % 64));
+        if (bits != 0) {
+            pos = pos / 64 * 64 + static_cast<size_t>(std::countr_zero(bits));
+            break;
+        }
+        if (k + 1 == pool.levels)
+            return pool.size;
+        // Continue with the next word, one level up.
+        pos = pos / 64 + 1;
+        bits_at_level = NodePool_words(bits_at_level);
+        ++k;
+    }
+    for (; k > 0; --k)
+        pos = pos * 64 + static_cast<size_t>(std::countr_zero(pool.free_bits[k - 1][pos]));
+    return pos;
+}
+
+// Return the oldest cached nodes to the bitmaps, keeping the keep most recent ones.
+template <typename Index>
+void NodePool_flushCache(NodePool<Index> &pool, const size_t keep = 0) {
+    if (pool.cached <= keep)
+        return;
+    const size_t n = pool.cached - keep;
+    NodePool_forEachWord(pool.cache, n, [&pool](const size_t w, const std::uint64_t mask) {
+        pool.cached_bits[w] &= ~mask;
+        NodePool_releaseWord(pool, w, mask);
+    });
+    std::copy(pool.cache + n, pool.cache + pool.cached, pool.cache);
+    pool.cached = keep;
+}
+
+// Free node idx into the cache. Returns false if it is out of range or not allocated.
+template <typename Index>
+bool NodePool_free(NodePool<Index> &pool, const size_t idx) {
+    if (!NodePool_isAllocated(pool, idx))
+        return false;
+    if (pool.cached == NODE_POOL_CACHE_SIZE)
+        NodePool_flushCache(pool, NODE_POOL_CACHE_SIZE / 2);
+    pool.cache[pool.cached++] = static_cast<Index>(idx);
+    pool.cached_bits[idx / 64] |= std::uint64_t{1} << (idx % 64);
+    --pool.count;
+    return true;
+}
+
+// Free n nodes given by their indices straight into the bitmaps, bypassing
+// the cache; unallocated ones are skipped. Returns the number of nodes freed.
+template <typename Index>
+size_t NodePool_freeN(NodePool<Index> &pool, const Index *indices, const size_t n) {
+    size_t freed = 0;
+    for (size_t i = 0; i < n;) {
+        const size_t w = static_cast<size_t>(indices[i]) / 64;
+        std::uint64_t mask = 0;
+        for (; i < n && static_cast<size_t>(indices[i]) / 64 == w; ++i) {
+            const size_t idx = static_cast<size_t>(indices[i]);
+            const std::uint64_t bit = std::uint64_t{1} << (idx % 64);
+            // Skip nodes that are free, including repeats within this run.
+            if (!NodePool_isAllocated(pool, idx) || (mask & bit) != 0)
+                continue;
+            mask |= bit;
+            ++freed;
+        }
+        if (mask != 0)
+            NodePool_releaseWord(pool, w, mask);
+    }
+    pool.count -= freed;
+    return freed;
+}
+
+// One past the highest allocated node, or 0 if no node is allocated.
+template <typename Index>
+size_t NodePool_usedEnd(const NodePool<Index> &pool) {
+    for (size_t w = NodePool_words(pool.size); w-- > 0;) {
+        std::uint64_t used = ~NodePool_freeWord(pool, w);
+        if (w == pool.size / 64)
+            used &= (std::uint64_t{1} << (pool.size % 64)) - 1;
+        if (used != 0)
+            return w * 64 + 64 - static_cast<size_t>(std::countl_zero(used));
+    }
+    return 0;
+}
+
+// Shrink the pool to new_size nodes, dropping the nodes above it.
+// Returns false (leaving the pool unchanged) if new_size is larger than the
+// pool or a node at or above new_size is still allocated.
+template <typename Index>
+bool NodePool_shrink(NodePool<Index> &pool, const size_t new_size) {
+    if (new_size > pool.size || NodePool_usedEnd(pool) > new_size)
+        return false;
+    NodePool_flushCache(pool);
+    auto free_bits = std::make_unique<std::uint64_t[]>(NodePool_words(new_size));
+    std::copy_n(pool.free_bits[0].get(), NodePool_words(new_size), free_bits.get());
+    if (new_size % 64 != 0)
+        free_bits[new_size / 64] &= (std::uint64_t{1} << (new_size % 64)) - 1;
+    NodePool_build(pool, std::move(free_bits), new_size);
+    return true;
+}
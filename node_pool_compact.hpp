@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.hpp"
+
+// Incremental compaction of pool-based lists. A pass renumbers the live
+// nodes so that traversal order is sequential in memory: the i-th node in
+// traversal order ends up in slot i (or slot count - 1 - i for a
+// descending layout), and the free nodes form one contiguous tail. The
+// pass runs in slices of bounded work, and the list may be used between
+// slices; nodes added or removed meanwhile only make the result less
+// tight, never inconsistent.
+//
+// Doubly linked lists swap each node into its slot in O(1). Singly linked
+// lists cannot find the predecessor of the node occupying a slot, so they
+// first move the nodes in the way above the target range, then place
+// every node, always relinking through the node handled just before it.
+// If the free nodes above the target range run out during the first step,
+// the pool grows; once the pass completes, the pool is shrunk back to the
+// size it had when the pass started (or to just past the last live node,
+// if nodes added between slices still sit above that).
+
+// Phases of a compaction pass.
+enum class NodePoolCompactPhase : std::uint8_t {
+    Idle,     // Not started.
+    Evacuate, // Singly linked lists: move nodes that are in the way above the target range.
+    Place,    // Move each node into its slot, in traversal order.
+    Done      // Pass complete.
+};
+
+// Progress of an incremental compaction pass. Start from a default-constructed value.
+template <typename Index = int>
+struct NodePoolCompaction {
+    NodePoolCompactPhase phase{NodePoolCompactPhase::Idle}; // Current phase.
+    Index cursor{NULL_INDEX<Index>};                        // Last node handled in this phase (NULL_INDEX: none yet).
+    size_t position{0};                                     // Traversal position of the next node.
+    size_t limit{0};                                        // Live nodes when the pass started; the target range is [0, limit).
+    size_t size{0};                                         // Pool size when the pass started.
+};
+
+// Node arrays and end pointers of a pool-based list, as the compaction pass sees them.
+template <typename T, typename Index>
+struct NodePoolLinks {
+    T *data{nullptr};     // Node values.
+    Index *next{nullptr}; // Next pointers, in traversal order.
+    Index *prev{nullptr}; // Previous pointers, or nullptr for a singly linked list.
+    Index *head{nullptr}; // First node in traversal order.
+    Index *tail{nullptr}; // Last node, or nullptr if the container does not track it.
+    bool descending{false}; // Lay nodes out at descending indices.
+};
+
+// Fraction of next links in traversal order that do not lead to the
+// adjacent slot (the one above, or below for a descending layout).
+// 0 means traversal is one sequential sweep through memory.
+template <typename Index>
+double NodePool_fragmentation(const Index *next, const Index head, const bool descending) {
+    size_t links = 0;
+    size_t breaks = 0;
+    for (Index current = head; current != NULL_INDEX<Index> && next[current] != NULL_INDEX<Index>;
+         current = next[current]) {
+        const size_t adjacent = descending ? static_cast<size_t>(current) - 1 : static_cast<size_t>(current) + 1;
+        ++links;
+        breaks += static_cast<size_t>(next[current]) != adjacent;
+    }
+    return (links > 0) ? static_cast<double>(breaks) / static_cast<double>(links) : 0.0;
+}
+
+// Move live node x into free slot t. pred is the node before x in
+// traversal order, or NULL_INDEX if x is the head.
+template <typename T, typename Index>
+void NodePool_moveNode(NodePool<Index> &pool, const NodePoolLinks<T, Index> &links, const Index pred,
+                       const Index x, const Index t) {
+    NodePool_allocateAt(pool, t);
+    links.data[t] = std::move(links.data[x]);
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        links.data[x] = T{}; // Release resources held by the payload.
+    links.next[t] = links.next[x];
+    links.next[x] = NULL_INDEX<Index>;
+    (pred == NULL_INDEX<Index> ? *links.head : links.next[pred]) = t;
+    if (links.prev) {
+        links.prev[t] = links.prev[x];
+        links.prev[x] = NULL_INDEX<Index>;
+        if (links.next[t] != NULL_INDEX<Index>)
+            links.prev[links.next[t]] = t;
+    }
+    if (links.tail && *links.tail == x)
+        *links.tail = t;
+    NodePool_free(pool, x);
+}
+
+// Swap live nodes a and b of a doubly linked list: each takes over the
+// other's slot, and every link to one is redirected to the other.
+template <typename T, typename Index>
+void NodePool_swapNodes(const NodePoolLinks<T, Index> &links, const Index a, const Index b) {
+    auto swapped = [a, b](const Index i) { return (i == a) ? b : (i == b) ? a : i; };
+    const Index neighbours[4] = {links.prev[a], links.next[a], links.prev[b], links.next[b]};
+    std::swap(links.data[a], links.data[b]);
+    std::swap(links.next[a], links.next[b]);
+    std::swap(links.prev[a], links.prev[b]);
+    for (const Index i : {a, b}) {
+        links.next[i] = swapped(links.next[i]);
+        links.prev[i] = swapped(links.prev[i]);
+    }
+    for (int k = 0; k < 4; ++k) {
+        const Index n = neighbours[k];
+        // A node between a and b is listed twice; relabel it only once.
+        if (n == NULL_INDEX<Index> || n == a || n == b || std::find(neighbours, neighbours + k, n) != neighbours + k)
+            continue;
+        links.next[n] = swapped(links.next[n]);
+        links.prev[n] = swapped(links.prev[n]);
+    }
+    *links.head = swapped(*links.head);
+    if (links.tail)
+        *links.tail = swapped(*links.tail);
+}
+
+// Run one slice of a compaction pass, handling at most budget nodes.
+// make_links() returns the list's current NodePoolLinks; grow() grows the
+// pool and returns false if it cannot, after which make_links() is called
+// again. shrink(n) truncates the pool and node arrays to n nodes, all above
+// which are free; it is called once at the end of the pass if the pool is
+// larger than when the pass started. Returns true once the pass is complete.
+template <typename Index, typename MakeLinks, typename Grow, typename Shrink>
+bool NodePool_compactStep(NodePool<Index> &pool, NodePoolCompaction<Index> &state, size_t budget,
+                          MakeLinks make_links, Grow grow, Shrink shrink) {
+    using Phase = NodePoolCompactPhase;
+    if (state.phase == Phase::Done)
+        return true;
+    auto links = make_links();
+    if (state.phase == Phase::Idle) {
+        state.phase = links.prev ? Phase::Place : Phase::Evacuate;
+        state.cursor = NULL_INDEX<Index>;
+        state.position = 0;
+        state.limit = pool.count;
+        state.size = pool.size;
+        // Let the evacuation see every free node above the target range.
+        NodePool_flushCache(pool);
+    }
+    // The last handled node was removed between slices: restart the phase.
+    if (state.cursor != NULL_INDEX<Index> && !NodePool_isAllocated(pool, state.cursor)) {
+        state.cursor = NULL_INDEX<Index>;
+        state.position = 0;
+    }
+
+    for (; budget > 0; --budget) {
+        const Index x = (state.cursor == NULL_INDEX<Index>) ? *links.head : links.next[state.cursor];
+        if (x == NULL_INDEX<Index>) {
+            if (state.phase == Phase::Place) {
+                state.phase = Phase::Done;
+                // Give back the nodes the pool grew by during the pass.
+                const size_t end = std::max(state.size, NodePool_usedEnd(pool));
+                if (end < pool.size)
+                    shrink(end);
+                return true;
+            }
+            state.phase = Phase::Place;
+            state.cursor = NULL_INDEX<Index>;
+            state.position = 0;
+            continue;
+        }
+        // Slot of the node at this traversal position, if it has one.
+        const bool has_slot = state.position < state.limit;
+        const size_t slot = !has_slot ? pool.size
+                            : links.descending ? state.limit - 1 - state.position
+                                               : state.position;
+        Index at = x;
+        if (state.phase == Phase::Evacuate) {
+            // Move a node out of the target range unless it already sits in its own slot.
+            if (static_cast<size_t>(x) < state.limit && static_cast<size_t>(x) != slot) {
+                size_t t = NodePool_nextFree(pool, state.limit);
+                if (t == pool.size && grow()) {
+                    links = make_links();
+                    t = NodePool_nextFree(pool, state.limit);
+                }
+                if (t < pool.size) {
+                    NodePool_moveNode(pool, links, state.cursor, x, static_cast<Index>(t));
+                    at = static_cast<Index>(t);
+                }
+            }
+        } else if (has_slot && static_cast<size_t>(x) != slot) {
+            if (!NodePool_isAllocated(pool, slot)) {
+                NodePool_moveNode(pool, links, state.cursor, x, static_cast<Index>(slot));
+                at = static_cast<Index>(slot);
+            } else if (links.prev) {
+                NodePool_swapNodes(links, x, static_cast<Index>(slot));
+                at = static_cast<Index>(slot);
+            }
+        }
+        state.cursor = at;
+        ++state.position;
+    }
+    return false;
+}
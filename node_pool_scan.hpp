@@ -0,0 +1,225 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "node_pool.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Order-independent scans over a pool's payload array. Instead of following
+// next links, the payload array is streamed 64 nodes at a time and matched
+// against the level-0 free bitmap, so only allocated nodes are reported and
+// words without any allocated node are skipped.
+
+// Comparators that the scans evaluate with SIMD compares.
+enum class NodePoolCompare {
+    EqualTo,
+    NotEqualTo,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Other // Any other predicate; evaluated element by element.
+};
+
+// Kind of a comparator: std::equal_to<>, std::less<T> and so on, or Other.
+template <typename T, typename Compare>
+constexpr NodePoolCompare NodePool_compareKind() {
+    if constexpr (std::is_same_v<Compare, std::equal_to<>> || std::is_same_v<Compare, std::equal_to<T>>)
+        return NodePoolCompare::EqualTo;
+    else if constexpr (std::is_same_v<Compare, std::not_equal_to<>> || std::is_same_v<Compare, std::not_equal_to<T>>)
+        return NodePoolCompare::NotEqualTo;
+    else if constexpr (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>)
+        return NodePoolCompare::Less;
+    else if constexpr (std::is_same_v<Compare, std::less_equal<>> || std::is_same_v<Compare, std::less_equal<T>>)
+        return NodePoolCompare::LessEqual;
+    else if constexpr (std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>)
+        return NodePoolCompare::Greater;
+    else if constexpr (std::is_same_v<Compare, std::greater_equal<>> || std::is_same_v<Compare, std::greater_equal<T>>)
+        return NodePoolCompare::GreaterEqual;
+    else
+        return NodePoolCompare::Other;
+}
+
+// Whether a 64-node block of T can be matched against Compare with SIMD compares.
+template <typename T, typename Compare>
+constexpr bool NodePool_simdScan =
+#if defined(__SSE2__)
+    (std::is_same_v<T, float> || std::is_same_v<T, std::int32_t>) &&
+    NodePool_compareKind<T, Compare>() != NodePoolCompare::Other;
+#else
+    false;
+#endif
+
+#if defined(__SSE2__)
+// Bit i set while compare(data[i], value) holds, for the 64 floats at data.
+template <NodePoolCompare kind>
+std::uint64_t NodePool_matchFloats(const float *data, const float value) {
+    std::uint64_t mask = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    // Ordered predicates are false for NaN, and not-equal is unordered, as in C++.
+    constexpr int predicate = (kind == NodePoolCompare::EqualTo)      ? _CMP_EQ_OQ
+                              : (kind == NodePoolCompare::NotEqualTo) ? _CMP_NEQ_UQ
+                              : (kind == NodePoolCompare::Less)       ? _CMP_LT_OQ
+                              : (kind == NodePoolCompare::LessEqual)  ? _CMP_LE_OQ
+                              : (kind == NodePoolCompare::Greater)    ? _CMP_GT_OQ
+                                                                      : _CMP_GE_OQ;
+#endif
+#if defined(__AVX512F__)
+    const __m512 needle = _mm512_set1_ps(value);
+    for (int i = 0; i < 64; i += 16)
+        mask |= std::uint64_t{_mm512_cmp_ps_mask(_mm512_loadu_ps(data + i), needle, predicate)} << i;
+#elif defined(__AVX2__)
+    const __m256 needle = _mm256_set1_ps(value);
+    for (int i = 0; i < 64; i += 8) {
+        __m256 lanes = _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, predicate);
+        mask |= std::uint64_t{static_cast<unsigned>(_mm256_movemask_ps(lanes))} << i;
+    }
+#else
+    const __m128 needle = _mm_set1_ps(value);
+    for (int i = 0; i < 64; i += 4) {
+        const __m128 block = _mm_loadu_ps(data + i);
+        __m128 lanes;
+        if constexpr (kind == NodePoolCompare::EqualTo)
+            lanes = _mm_cmpeq_ps(block, needle);
+        else if constexpr (kind == NodePoolCompare::NotEqualTo)
+            lanes = _mm_cmpneq_ps(block, needle);
+        else if constexpr (kind == NodePoolCompare::Less)
+            lanes = _mm_cmplt_ps(block, needle);
+        else if constexpr (kind == NodePoolCompare::LessEqual)
+            lanes = _mm_cmple_ps(block, needle);
+        else if constexpr (kind == NodePoolCompare::Greater)
+            lanes = _mm_cmpgt_ps(block, needle);
+        else
+            lanes = _mm_cmpge_ps(block, needle);
+        mask |= std::uint64_t{static_cast<unsigned>(_mm_movemask_ps(lanes))} << i;
+    }
+#endif
+    return mask;
+}
+
+// Bit i set while compare(data[i], value) holds, for the 64 32-bit integers at data.
+// Equal and greater are compared in SIMD; the other relations are derived from them.
+template <NodePoolCompare kind>
+std::uint64_t NodePool_matchInts(const std::int32_t *data, const std::int32_t value) {
+    std::uint64_t eq = 0;
+    std::uint64_t gt = 0;
+#if defined(__AVX512F__)
+    const __m512i needle = _mm512_set1_epi32(value);
+    for (int i = 0; i < 64; i += 16) {
+        const __m512i block = _mm512_loadu_si512(data + i);
+        eq |= std::uint64_t{_mm512_cmpeq_epi32_mask(block, needle)} << i;
+        gt |= std::uint64_t{_mm512_cmpgt_epi32_mask(block, needle)} << i;
+    }
+#elif defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32(value);
+    for (int i = 0; i < 64; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        eq |= std::uint64_t{static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle))))} << i;
+        gt |= std::uint64_t{static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, needle))))} << i;
+    }
+#else
+    const __m128i needle = _mm_set1_epi32(value);
+    for (int i = 0; i < 64; i += 4) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        eq |= std::uint64_t{static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle))))} << i;
+        gt |= std::uint64_t{static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, needle))))} << i;
+    }
+#endif
+    if constexpr (kind == NodePoolCompare::EqualTo)
+        return eq;
+    else if constexpr (kind == NodePoolCompare::NotEqualTo)
+        return ~eq;
+    else if constexpr (kind == NodePoolCompare::Less)
+        return ~(eq | gt);
+    else if constexpr (kind == NodePoolCompare::LessEqual)
+        return ~gt;
+    else if constexpr (kind == NodePoolCompare::Greater)
+        return gt;
+    else
+        return eq | gt;
+}
+#endif
+
+// Bit i set while node 64 * w + i is allocated.
+template <typename Index>
+std::uint64_t NodePool_liveBits(const NodePool<Index> &pool, const size_t w) {
+    std::uint64_t live = ~NodePool_freeWord(pool, w);
+    // Bits past the end of the pool are clear in the free bitmap; mask them off.
+    if (w == pool.size / 64)
+        live &= (std::uint64_t{1} << (pool.size % 64)) - 1;
+    return live;
+}
+
+// Bit i set while node 64 * w + i is allocated and compare(data[64 * w + i], value) holds.
+// Only live nodes are compared, except that whole blocks of float or int32
+// payloads are compared with SIMD and masked afterwards.
+template <typename T, typename Index, typename Compare>
+std::uint64_t NodePool_matchWord(const NodePool<Index> &pool, const T *data, const size_t w,
+                                 const Compare &compare, const T &value) {
+    const std::uint64_t live = NodePool_liveBits(pool, w);
+    const T *block = data + 64 * w;
+    std::uint64_t matches = 0;
+    if (live == 0)
+        return 0;
+#if defined(__SSE2__)
+    if constexpr (NodePool_simdScan<T, Compare>) {
+        // A whole block lies inside the pool unless it is the partial last word.
+        if (64 * (w + 1) <= pool.size) {
+            if constexpr (std::is_same_v<T, float>)
+                return NodePool_matchFloats<NodePool_compareKind<T, Compare>()>(block, value) & live;
+            else
+                return NodePool_matchInts<NodePool_compareKind<T, Compare>()>(block, value) & live;
+        }
+    }
+#endif
+    if (live == ~std::uint64_t{0}) {
+        // Every node is live: branch-free, so the compiler can vectorize it.
+        for (int i = 0; i < 64; ++i)
+            matches |= std::uint64_t{static_cast<bool>(compare(block[i], value))} << i;
+        return matches;
+    }
+    for (std::uint64_t bits = live; bits != 0; bits &= bits - 1) {
+        const int i = std::countr_zero(bits);
+        matches |= std::uint64_t{static_cast<bool>(compare(block[i], value))} << i;
+    }
+    return matches;
+}
+
+// Count the allocated nodes whose payload satisfies compare(payload, value).
+template <typename T, typename Index, typename Compare>
+size_t NodePool_countIf(const NodePool<Index> &pool, const T *data, const Compare &compare, const T &value) {
+    size_t matched = 0;
+    const size_t words = NodePool_words(pool.size);
+    for (size_t w = 0; w < words; ++w)
+        matched += static_cast<size_t>(std::popcount(NodePool_matchWord(pool, data, w, compare, value)));
+    return matched;
+}
+
+// Check whether any allocated node's payload equals value. Stops at the first match.
+template <typename T, typename Index>
+bool NodePool_contains(const NodePool<Index> &pool, const T *data, const T &value) {
+    const size_t words = NodePool_words(pool.size);
+    for (size_t w = 0; w < words; ++w)
+        if (NodePool_matchWord(pool, data, w, std::equal_to<>{}, value) != 0)
+            return true;
+    return false;
+}
+
+// Append to out the index of every allocated node whose payload satisfies
+// compare(payload, value), in pool order (not list order).
+template <typename T, typename Index, typename Compare>
+void NodePool_findAll(const NodePool<Index> &pool, const T *data, const Compare &compare, const T &value,
+                      std::vector<Index> &out) {
+    const size_t words = NodePool_words(pool.size);
+    for (size_t w = 0; w < words; ++w)
+        for (std::uint64_t bits = NodePool_matchWord(pool, data, w, compare, value); bits != 0; bits &= bits - 1)
+            out.push_back(static_cast<Index>(64 * w + static_cast<size_t>(std::countr_zero(bits))));
+}
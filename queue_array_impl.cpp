@@ -1,92 +1,147 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
+#include "node_pool_compact.hpp"
 
 // Queue structure using a free-node pool for storage.
+template <typename T, typename Index = int>
 struct Queue {
-    int front{-1}; // Index of the front element.
-    int rear{-1};  // Index of the rear element.
+    Index front{NULL_INDEX<Index>}; // Index of the front element.
+    Index rear{NULL_INDEX<Index>};  // Index of the rear element.
     
-    // Free node pool holding node arrays and free list information.
+    // Free node pool holding node arrays and their occupancy allocator.
     struct {
-        std::unique_ptr<float[]> data{nullptr};    // Node values.
-        std::unique_ptr<int[]> next{nullptr};        // Next pointers for linking nodes.
-        std::unique_ptr<int[]> next_free{nullptr};   // Free list linking.
-        std::unique_ptr<bool[]> allocated{nullptr};  // Allocation flags.
-        size_t size{0};                              // Total number of nodes.
-        int free_head{-1};                           // Head of the free list.
+        std::unique_ptr<T[]> data{nullptr};     // Node values.
+        std::unique_ptr<Index[]> next{nullptr}; // Next pointers for linking nodes.
+        NodePool<Index> slots;                  // Occupancy bitmap allocator.
+        bool growable{true};                    // Grow the pool when it runs out of free nodes.
     } free_node_stack;
 };
 
 // Initialize the queue with N nodes.
-// All nodes are initially free and linked as a free stack.
-void Queue_init(Queue &queue, const size_t &N) {
-    queue.front = -1;
-    queue.rear = -1;
-    queue.free_node_stack.size = N;
-    queue.free_node_stack.data = std::make_unique<float[]>(N);
-    queue.free_node_stack.next = std::make_unique<int[]>(N);
-    queue.free_node_stack.next_free = std::make_unique<int[]>(N);
-    queue.free_node_stack.allocated = std::make_unique<bool[]>(N);
-    queue.free_node_stack.free_head = 0; // Free list starts at index 0.
+// All nodes are initially free.
+template <typename T, typename Index>
+void Queue_init(Queue<T, Index> &queue, const size_t &N) {
+    queue.front = NULL_INDEX<Index>;
+    queue.rear = NULL_INDEX<Index>;
+    NodePool_init(queue.free_node_stack.slots, N);
+    queue.free_node_stack.data = make_payload_array<T>(N);
+    queue.free_node_stack.next = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i) {
-        queue.free_node_stack.data[i] = 0.0f;
-        queue.free_node_stack.next[i] = -1;
-        queue.free_node_stack.allocated[i] = false;
-        queue.free_node_stack.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+        queue.free_node_stack.next[i] = NULL_INDEX<Index>;
     }
 }
 
-// Allocate a node by "popping" from the free list.
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool Queue_growPool(Queue<T, Index> &queue) {
+    const size_t old_size = queue.free_node_stack.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(queue.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(queue.free_node_stack.data.get(), queue.free_node_stack.data.get() + old_size, data.get());
+    std::copy_n(queue.free_node_stack.next.get(), old_size, next.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        next[i] = NULL_INDEX<Index>;
+    }
+
+    queue.free_node_stack.data = std::move(data);
+    queue.free_node_stack.next = std::move(next);
+    return true;
+}
+
+// Shrink the pool to new_size nodes, releasing the node arrays above it.
+// Every node at or above new_size must be free; returns false otherwise.
+template <typename T, typename Index>
+bool Queue_shrinkPool(Queue<T, Index> &queue, const size_t new_size) {
+    if (!NodePool_shrink(queue.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(queue.free_node_stack.data.get(), queue.free_node_stack.data.get() + new_size, data.get());
+    std::copy_n(queue.free_node_stack.next.get(), new_size, next.get());
+
+    queue.free_node_stack.data = std::move(data);
+    queue.free_node_stack.next = std::move(next);
+    return true;
+}
+
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
 // Sets the node's value and marks it as allocated.
 // Returns the allocated node index via node_idx.
-void Queue_allocateNode(Queue &queue, const float &value, int &node_idx) {
-    node_idx = -1;
-    if (queue.free_node_stack.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void Queue_allocateNode(Queue<T, Index> &queue, const T &value, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(queue.free_node_stack.slots) &&
+        !(queue.free_node_stack.growable && Queue_growPool(queue))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // Pop the node from the free list.
-    node_idx = queue.free_node_stack.free_head;
-    queue.free_node_stack.free_head = queue.free_node_stack.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(queue.free_node_stack.slots, node_idx);
 
     // Initialize the allocated node.
     queue.free_node_stack.data[node_idx] = value;
-    queue.free_node_stack.next[node_idx] = -1;
-    queue.free_node_stack.allocated[node_idx] = true;
+    queue.free_node_stack.next[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by "pushing" it back onto the free list.
+// Deallocate a node by returning it to the pool.
 // Checks for double deallocation.
-void Queue_deallocateNode(Queue &queue, const size_t &idx) {
-    if (idx >= queue.free_node_stack.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+template <typename T, typename Index>
+void Queue_deallocateNode(Queue<T, Index> &queue, const size_t &idx) {
+    if (idx >= queue.free_node_stack.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
-    if (!queue.free_node_stack.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(queue.free_node_stack.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     
     // Reset node's value and next pointer.
-    queue.free_node_stack.data[idx] = 0.0f;
-    queue.free_node_stack.next[idx] = -1;
-    queue.free_node_stack.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        queue.free_node_stack.data[idx] = T{}; // Release resources held by the payload.
+    queue.free_node_stack.next[idx] = NULL_INDEX<Index>;
     
-    // Push the node back to the free list.
-    queue.free_node_stack.next_free[idx] = queue.free_node_stack.free_head;
-    queue.free_node_stack.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(queue.free_node_stack.slots, idx);
 }
 
 // Enqueue a value into the queue.
-void Queue_enqueue(Queue &queue, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void Queue_enqueue(Queue<T, Index> &queue, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     Queue_allocateNode(queue, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
     
     // If the queue is empty, set front and rear to the new node.
-    if (queue.front == -1) {
+    if (queue.front == NULL_INDEX<Index>) {
         queue.front = new_node;
         queue.rear = new_node;
     } else {
@@ -96,51 +151,294 @@ void Queue_enqueue(Queue &queue, const float &value) {
     }
 }
 
-// Dequeue a value from the queue.
-// Returns the value that was removed.
-float Queue_dequeue(Queue &queue) {
-    if (queue.front == -1) {
-        std::cerr << "Error: Queue underflow." << std::endl;
-        return 0.0f;
-    }
-    int node_idx = queue.front;
-    float value = queue.free_node_stack.data[node_idx];
+// Dequeue a value from the queue without reporting an error.
+// Returns the value that was removed, or ContainerError::Empty if the queue is empty.
+template <typename T, typename Index>
+std::expected<T, ContainerError> Queue_tryDequeue(Queue<T, Index> &queue) {
+    if (queue.front == NULL_INDEX<Index>)
+        return std::unexpected(ContainerError::Empty);
+    Index node_idx = queue.front;
+    T value = std::move(queue.free_node_stack.data[node_idx]);
     
     // Move front to the next node.
     queue.front = queue.free_node_stack.next[node_idx];
     // If the queue becomes empty, reset the rear pointer.
-    if (queue.front == -1)
-        queue.rear = -1;
+    if (queue.front == NULL_INDEX<Index>)
+        queue.rear = NULL_INDEX<Index>;
     
     // Deallocate the node.
     Queue_deallocateNode(queue, node_idx);
     return value;
 }
 
+// Dequeue a value from the queue.
+// Returns the value that was removed.
+template <typename T, typename Index>
+T Queue_dequeue(Queue<T, Index> &queue) {
+    auto value = Queue_tryDequeue(queue);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Queue underflow.");
+        return T{};
+    }
+    return std::move(*value);
+}
+
 // Peek at the value at the front of the queue without dequeuing.
-float Queue_peek(const Queue &queue) {
-    if (queue.front == -1) {
-        std::cerr << "Error: Queue is empty." << std::endl;
-        return 0.0f;
+template <typename T, typename Index>
+T Queue_peek(const Queue<T, Index> &queue) {
+    if (queue.front == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::Empty, "Queue is empty.");
+        return T{};
     }
     return queue.free_node_stack.data[queue.front];
 }
 
+// Run one slice of an incremental compaction, handling at most budget nodes.
+// Renumbers the live nodes so that the queue reads front to rear as
+// ascending consecutive indices, which later enqueues continue, and leaves
+// the free nodes as one contiguous tail. Other operations may run between
+// slices. Start with a default-constructed state; returns true once the
+// pass is complete.
+template <typename T, typename Index>
+bool Queue_compactStep(Queue<T, Index> &queue, NodePoolCompaction<Index> &state, const size_t budget) {
+    auto make_links = [&queue] {
+        return NodePoolLinks<T, Index>{queue.free_node_stack.data.get(), queue.free_node_stack.next.get(), nullptr,
+                                       &queue.front, &queue.rear, false};
+    };
+    auto grow = [&queue] { return queue.free_node_stack.growable && Queue_growPool(queue); };
+    auto shrink = [&queue](const size_t new_size) { Queue_shrinkPool(queue, new_size); };
+    return NodePool_compactStep(queue.free_node_stack.slots, state, budget, make_links, grow, shrink);
+}
+
+// Compact the queue in a single pass.
+template <typename T, typename Index>
+void Queue_compact(Queue<T, Index> &queue) {
+    NodePoolCompaction<Index> state;
+    Queue_compactStep(queue, state, std::numeric_limits<size_t>::max());
+}
+
+// Fraction of links that do not lead to the adjacent node slot (0: fully sequential).
+template <typename T, typename Index>
+double Queue_fragmentation(const Queue<T, Index> &queue) {
+    return NodePool_fragmentation(queue.free_node_stack.next.get(), queue.front, false);
+}
+
 // Print the contents of the queue (from front to rear).
-void Queue_print(const Queue &queue) {
-    int current = queue.front;
+template <typename T, typename Index>
+void Queue_print(const Queue<T, Index> &queue) {
+    Index current = queue.front;
     std::cout << "Queue: ";
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         std::cout << queue.free_node_stack.data[current] << " ";
         current = queue.free_node_stack.next[current];
     }
     std::cout << std::endl;
 }
 
+// Cache line size used to keep concurrently written counters apart.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded single-producer/single-consumer ring-buffer queue.
+// Capacity is a power of two, so positions wrap with a mask.
+// Each side owns one cache line: its own counter plus a cached copy of
+// the other side's counter, which is only refreshed when the ring looks
+// full (producer) or empty (consumer). Both operations are wait-free.
+template <typename T>
+struct SPSCQueue {
+    alignas(CACHE_LINE_SIZE) struct {
+        std::atomic<size_t> tail{0};  // Next position to write.
+        size_t cached_head{0};        // Producer's last seen value of head.
+    } producer;
+
+    alignas(CACHE_LINE_SIZE) struct {
+        std::atomic<size_t> head{0};  // Next position to read.
+        size_t cached_tail{0};        // Consumer's last seen value of tail.
+    } consumer;
+
+    alignas(CACHE_LINE_SIZE) struct {
+        std::unique_ptr<T[]> data{nullptr};     // Slot values.
+        size_t mask{0};                         // Capacity - 1.
+    } ring;
+};
+
+// Initialize the SPSC queue with room for at least `capacity` values.
+// The capacity is rounded up to the next power of two.
+template <typename T>
+void SPSCQueue_init(SPSCQueue<T> &queue, const size_t capacity) {
+    const size_t size = std::bit_ceil(std::max<size_t>(capacity, 1));
+    queue.ring.data = std::make_unique<T[]>(size);
+    queue.ring.mask = size - 1;
+    queue.producer.tail.store(0, std::memory_order_relaxed);
+    queue.producer.cached_head = 0;
+    queue.consumer.head.store(0, std::memory_order_relaxed);
+    queue.consumer.cached_tail = 0;
+}
+
+// Enqueue up to n values from `values` (producer thread only).
+// Publishes the whole batch with a single release store.
+// Returns the number of values enqueued.
+template <typename T>
+size_t SPSCQueue_enqueueN(SPSCQueue<T> &queue, const T *values, const size_t n) {
+    const size_t tail = queue.producer.tail.load(std::memory_order_relaxed);
+    const size_t capacity = queue.ring.mask + 1;
+    if (capacity - (tail - queue.producer.cached_head) < n)
+        queue.producer.cached_head = queue.consumer.head.load(std::memory_order_acquire);
+
+    const size_t count = std::min(n, capacity - (tail - queue.producer.cached_head));
+    for (size_t i = 0; i < count; ++i)
+        queue.ring.data[(tail + i) & queue.ring.mask] = values[i];
+    queue.producer.tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+// Dequeue up to n values into `values` (consumer thread only).
+// Releases the whole batch of slots with a single release store.
+// Returns the number of values dequeued.
+template <typename T>
+size_t SPSCQueue_dequeueN(SPSCQueue<T> &queue, T *values, const size_t n) {
+    const size_t head = queue.consumer.head.load(std::memory_order_relaxed);
+    if (queue.consumer.cached_tail - head < n)
+        queue.consumer.cached_tail = queue.producer.tail.load(std::memory_order_acquire);
+
+    const size_t count = std::min(n, queue.consumer.cached_tail - head);
+    for (size_t i = 0; i < count; ++i)
+        values[i] = std::move(queue.ring.data[(head + i) & queue.ring.mask]);
+    queue.consumer.head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+// Enqueue a single value (producer thread only).
+// Returns false if the queue is full.
+template <typename T>
+bool SPSCQueue_enqueue(SPSCQueue<T> &queue, const T &value) {
+    return SPSCQueue_enqueueN(queue, &value, 1) == 1;
+}
+
+// Dequeue a single value (consumer thread only).
+// Returns false if the queue is empty.
+template <typename T>
+bool SPSCQueue_dequeue(SPSCQueue<T> &queue, T &value) {
+    return SPSCQueue_dequeueN(queue, &value, 1) == 1;
+}
+
+// Bounded multi-producer/multi-consumer ring-buffer queue.
+// Each cell carries a sequence number that tells producers and consumers
+// whether the cell is ready for them at a given position, so a claim is a
+// single CAS on the shared position counter and value and sequence share
+// one cache line. Operations are lock-free.
+template <typename T>
+struct MPMCQueue {
+    // A ring slot: sequence number and value side by side.
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos{0}; // Next position to claim for writing.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos{0}; // Next position to claim for reading.
+
+    alignas(CACHE_LINE_SIZE) struct {
+        std::unique_ptr<Cell[]> cells{nullptr}; // Ring slots.
+        size_t mask{0};                         // Capacity - 1.
+    } ring;
+};
+
+// Initialize the MPMC queue with room for at least `capacity` values.
+// The capacity is rounded up to the next power of two.
+template <typename T>
+void MPMCQueue_init(MPMCQueue<T> &queue, const size_t capacity) {
+    const size_t size = std::bit_ceil(std::max<size_t>(capacity, 1));
+    queue.ring.cells = std::make_unique<typename MPMCQueue<T>::Cell[]>(size);
+    queue.ring.mask = size - 1;
+    for (size_t i = 0; i < size; ++i)
+        queue.ring.cells[i].sequence.store(i, std::memory_order_relaxed);
+    queue.enqueue_pos.store(0, std::memory_order_relaxed);
+    queue.dequeue_pos.store(0, std::memory_order_relaxed);
+}
+
+// Enqueue up to n values from `values`.
+// Claims the longest run of free cells (at most n) with one CAS, then
+// fills and publishes them. Returns the number of values enqueued.
+template <typename T>
+size_t MPMCQueue_enqueueN(MPMCQueue<T> &queue, const T *values, const size_t n) {
+    if (n == 0)
+        return 0;
+    size_t pos = queue.enqueue_pos.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (true) {
+        // Count cells that are free for positions pos, pos + 1, ...
+        count = 0;
+        while (count < n &&
+               queue.ring.cells[(pos + count) & queue.ring.mask].sequence.load(std::memory_order_acquire) == pos + count)
+            ++count;
+        if (count == 0) {
+            const size_t seq = queue.ring.cells[pos & queue.ring.mask].sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(seq - pos) < 0)
+                return 0; // Full: the cell still holds a value from the previous lap.
+            pos = queue.enqueue_pos.load(std::memory_order_relaxed); // Another producer moved ahead.
+            continue;
+        }
+        if (queue.enqueue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            break;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        typename MPMCQueue<T>::Cell &cell = queue.ring.cells[(pos + i) & queue.ring.mask];
+        cell.data = values[i];
+        cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return count;
+}
+
+// Dequeue up to n values into `values`.
+// Claims the longest run of filled cells (at most n) with one CAS, then
+// reads them and hands the cells back to producers for the next lap.
+// Returns the number of values dequeued.
+template <typename T>
+size_t MPMCQueue_dequeueN(MPMCQueue<T> &queue, T *values, const size_t n) {
+    if (n == 0)
+        return 0;
+    size_t pos = queue.dequeue_pos.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (true) {
+        // Count cells that hold values for positions pos, pos + 1, ...
+        count = 0;
+        while (count < n &&
+               queue.ring.cells[(pos + count) & queue.ring.mask].sequence.load(std::memory_order_acquire) == pos + count + 1)
+            ++count;
+        if (count == 0) {
+            const size_t seq = queue.ring.cells[pos & queue.ring.mask].sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0)
+                return 0; // Empty: the cell has not been written for this lap.
+            pos = queue.dequeue_pos.load(std::memory_order_relaxed); // Another consumer moved ahead.
+            continue;
+        }
+        if (queue.dequeue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            break;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        typename MPMCQueue<T>::Cell &cell = queue.ring.cells[(pos + i) & queue.ring.mask];
+        values[i] = std::move(cell.data);
+        cell.sequence.store(pos + i + queue.ring.mask + 1, std::memory_order_release);
+    }
+    return count;
+}
+
+// Enqueue a single value. Returns false if the queue is full.
+template <typename T>
+bool MPMCQueue_enqueue(MPMCQueue<T> &queue, const T &value) {
+    return MPMCQueue_enqueueN(queue, &value, 1) == 1;
+}
+
+// Dequeue a single value. Returns false if the queue is empty.
+template <typename T>
+bool MPMCQueue_dequeue(MPMCQueue<T> &queue, T &value) {
+    return MPMCQueue_dequeueN(queue, &value, 1) == 1;
+}
+
 // Demonstration of queue operations.
 int main() {
     constexpr size_t N = 10;
-    Queue queue;
+    Queue<float> queue;
     
     // Initialize the queue with N nodes.
     Queue_init(queue, N);
@@ -159,5 +457,85 @@ int main() {
     // Peek at the front value.
     std::cout << "Peek: " << Queue_peek(queue) << std::endl;
     
+    // Enqueue past the initial capacity; the pool grows on demand.
+    for (int i = 0; i < 2 * static_cast<int>(N); ++i)
+        Queue_enqueue(queue, static_cast<float>(10 + i));
+    std::cout << "Pool size after growth: " << queue.free_node_stack.slots.size << std::endl;
+    Queue_print(queue);  // Expected output: 2.2 3.3 10 11 ... 29
+    
+    // Dequeued nodes leave holes at the front of the pool; compaction closes them.
+    Queue_dequeue(queue);
+    Queue_dequeue(queue);
+    Queue_enqueue(queue, 30.0f);
+    std::cout << "Fragmentation before compaction: " << Queue_fragmentation(queue) << std::endl;
+    Queue_compact(queue);
+    std::cout << "Fragmentation after compaction: " << Queue_fragmentation(queue) << std::endl;  // Expected: 0
+    Queue_print(queue);  // Expected output: 10 11 ... 30
+    
+    // Payload and index types are template parameters: strings linked
+    // with 16-bit indices. Dequeued strings are moved out of the pool.
+    Queue<std::string, std::uint16_t> names;
+    Queue_init(names, 2);
+    Queue_enqueue(names, std::string("alpha"));
+    Queue_enqueue(names, std::string("beta"));
+    Queue_enqueue(names, std::string("gamma"));
+    std::cout << "Dequeued name: " << Queue_dequeue(names) << std::endl;  // Expected: alpha
+    Queue_print(names);  // Expected output: beta gamma
+
+    // Stream values through the SPSC ring from a producer to a consumer thread.
+    constexpr int COUNT = 100000;
+    SPSCQueue<float> spsc;
+    SPSCQueue_init(spsc, 1024);
+    double spsc_sum = 0.0;
+    std::thread spsc_consumer([&spsc, &spsc_sum] {
+        float buffer[64];
+        for (int received = 0; received < COUNT;) {
+            size_t n = SPSCQueue_dequeueN(spsc, buffer, 64);
+            for (size_t i = 0; i < n; ++i)
+                spsc_sum += buffer[i];
+            received += static_cast<int>(n);
+        }
+    });
+    for (int i = 1; i <= COUNT; ++i)
+        while (!SPSCQueue_enqueue(spsc, static_cast<float>(i)))
+            std::this_thread::yield();
+    spsc_consumer.join();
+    std::cout << "SPSC sum: " << static_cast<long long>(spsc_sum) << std::endl;  // Expected: 5000050000
+    
+    // Share one MPMC ring between two producers and two consumers.
+    constexpr int THREADS = 2;
+    MPMCQueue<float> mpmc;
+    MPMCQueue_init(mpmc, 1024);
+    std::atomic<long long> mpmc_sum{0};
+    std::atomic<int> mpmc_received{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&mpmc, t] {
+            for (int i = 1 + t; i <= COUNT; i += THREADS)
+                while (!MPMCQueue_enqueue(mpmc, static_cast<float>(i)))
+                    std::this_thread::yield();
+        });
+        workers.emplace_back([&mpmc, &mpmc_sum, &mpmc_received] {
+            float value;
+            while (mpmc_received.load(std::memory_order_relaxed) < COUNT) {
+                if (MPMCQueue_dequeue(mpmc, value)) {
+                    mpmc_sum.fetch_add(static_cast<long long>(value), std::memory_order_relaxed);
+                    mpmc_received.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    std::cout << "MPMC sum: " << mpmc_sum.load() << std::endl;  // Expected: 5000050000
+
+    // Empty batches are a no-op, whether or not the ring holds values.
+    float batch[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    MPMCQueue_enqueue(mpmc, batch[0]);
+    std::cout << "Empty MPMC batches: " << MPMCQueue_enqueueN(mpmc, batch, 0) << " enqueued, "
+              << MPMCQueue_dequeueN(mpmc, batch, 0) << " dequeued" << std::endl; // Expected: 0 enqueued, 0 dequeued
+    
     return 0;
 }
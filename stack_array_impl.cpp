@@ -1,86 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <expected>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container_error.hpp"
+#include "node_pool.hpp"
+#include "node_pool_compact.hpp"
 
 // Stack structure using a free-node pool for storage.
+template <typename T, typename Index = int>
 struct Stack {
-    int top{-1}; // Index of the top element in the stack
+    Index top{NULL_INDEX<Index>}; // Index of the top element in the stack
 
-    // The free node pool holding node arrays and free list information.
+    // The free node pool holding node arrays and their occupancy allocator.
     struct {
-        std::unique_ptr<float[]> data{nullptr};    // Node values
-        std::unique_ptr<int[]> next{nullptr};        // Next pointers for linking nodes
-        std::unique_ptr<int[]> next_free{nullptr};   // Free list linking (free stack)
-        std::unique_ptr<bool[]> allocated{nullptr};  // Allocation flags
-        size_t size{0};                              // Total number of nodes
-        int free_head{-1};                           // Head of the free list (index of first free node)
+        std::unique_ptr<T[]> data{nullptr};     // Node values
+        std::unique_ptr<Index[]> next{nullptr}; // Next pointers for linking nodes
+        NodePool<Index> slots;                  // Occupancy bitmap allocator.
+        bool growable{true};                    // Grow the pool when it runs out of free nodes
     } free_node_stack;
 };
 
 // Initialize the stack with N nodes.
-// All nodes are initially free and linked as a free stack.
-void Stack_init(Stack &stack, const size_t &N) {
-    stack.top = -1;
-    stack.free_node_stack.size = N;
-    stack.free_node_stack.data = std::make_unique<float[]>(N);
-    stack.free_node_stack.next = std::make_unique<int[]>(N);
-    stack.free_node_stack.next_free = std::make_unique<int[]>(N);
-    stack.free_node_stack.allocated = std::make_unique<bool[]>(N);
-    stack.free_node_stack.free_head = 0; // Free list starts at index 0
+// All nodes are initially free.
+template <typename T, typename Index>
+void Stack_init(Stack<T, Index> &stack, const size_t &N) {
+    stack.top = NULL_INDEX<Index>;
+    NodePool_init(stack.free_node_stack.slots, N);
+    stack.free_node_stack.data = make_payload_array<T>(N);
+    stack.free_node_stack.next = std::make_unique<Index[]>(N);
 
     for (size_t i = 0; i < N; ++i) {
-        stack.free_node_stack.data[i] = 0.0f;
-        stack.free_node_stack.next[i] = -1;
-        stack.free_node_stack.allocated[i] = false;
-        stack.free_node_stack.next_free[i] = (i < N - 1) ? static_cast<int>(i + 1) : -1;
+        stack.free_node_stack.next[i] = NULL_INDEX<Index>;
     }
 }
 
-// Allocate a node by "popping" from the free stack.
+// Grow the pool geometrically (doubling) when every node is in use.
+// Node arrays are reallocated and copied, so existing indices stay valid.
+// Returns false if the pool cannot grow any further.
+template <typename T, typename Index>
+bool Stack_growPool(Stack<T, Index> &stack) {
+    const size_t old_size = stack.free_node_stack.slots.size;
+    const size_t new_size = (old_size > 0) ? 2 * old_size : 1;
+    if (!NodePool_grow(stack.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(stack.free_node_stack.data.get(), stack.free_node_stack.data.get() + old_size, data.get());
+    std::copy_n(stack.free_node_stack.next.get(), old_size, next.get());
+
+    for (size_t i = old_size; i < new_size; ++i) {
+        next[i] = NULL_INDEX<Index>;
+    }
+
+    stack.free_node_stack.data = std::move(data);
+    stack.free_node_stack.next = std::move(next);
+    return true;
+}
+
+// Shrink the pool to new_size nodes, releasing the node arrays above it.
+// Every node at or above new_size must be free; returns false otherwise.
+template <typename T, typename Index>
+bool Stack_shrinkPool(Stack<T, Index> &stack, const size_t new_size) {
+    if (!NodePool_shrink(stack.free_node_stack.slots, new_size))
+        return false;
+
+    auto data = make_payload_array<T>(new_size);
+    auto next = std::make_unique<Index[]>(new_size);
+
+    std::move(stack.free_node_stack.data.get(), stack.free_node_stack.data.get() + new_size, data.get());
+    std::copy_n(stack.free_node_stack.next.get(), new_size, next.get());
+
+    stack.free_node_stack.data = std::move(data);
+    stack.free_node_stack.next = std::move(next);
+    return true;
+}
+
+// Allocate the lowest free node from the pool.
+// Grows the pool first if every node is in use and the pool is growable.
 // Sets the node's value and marks it as allocated.
 // Returns the allocated node index via node_idx.
-void Stack_allocateNode(Stack &stack, const float &value, int &node_idx) {
-    node_idx = -1;
-    if (stack.free_node_stack.free_head == -1) {
-        std::cerr << "Error: No free node available." << std::endl;
+template <typename T, typename Index>
+void Stack_allocateNode(Stack<T, Index> &stack, const T &value, Index &node_idx) {
+    node_idx = NULL_INDEX<Index>;
+    if (NodePool_full(stack.free_node_stack.slots) &&
+        !(stack.free_node_stack.growable && Stack_growPool(stack))) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
         return;
     }
-    // Pop: take the node at free_head.
-    node_idx = stack.free_node_stack.free_head;
-    // Update free_head to the next free node.
-    stack.free_node_stack.free_head = stack.free_node_stack.next_free[node_idx];
+    // Take the lowest free node.
+    NodePool_allocate(stack.free_node_stack.slots, node_idx);
 
     // Initialize the allocated node.
     stack.free_node_stack.data[node_idx] = value;
-    stack.free_node_stack.next[node_idx] = -1;
-    stack.free_node_stack.allocated[node_idx] = true;
+    stack.free_node_stack.next[node_idx] = NULL_INDEX<Index>;
 }
 
-// Deallocate a node by "pushing" it back onto the free stack.
+// Deallocate a node by returning it to the pool.
 // Checks for double deallocation.
-void Stack_deallocateNode(Stack &stack, const size_t &idx) {
-    if (idx >= stack.free_node_stack.size) {
-        std::cerr << "Error: Index out of bounds in deallocation." << std::endl;
+template <typename T, typename Index>
+void Stack_deallocateNode(Stack<T, Index> &stack, const size_t &idx) {
+    if (idx >= stack.free_node_stack.slots.size) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Index out of bounds in deallocation.");
         return;
     }
-    if (!stack.free_node_stack.allocated[idx]) {
-        std::cerr << "Error: Node " << idx << " is already deallocated." << std::endl;
+    if (!NodePool_isAllocated(stack.free_node_stack.slots, idx)) {
+        CONTAINER_ERROR(ContainerError::NotAllocated, "Node " << idx << " is already deallocated.");
         return;
     }
     // Reset node's value and next pointer.
-    stack.free_node_stack.data[idx] = 0.0f;
-    stack.free_node_stack.next[idx] = -1;
-    stack.free_node_stack.allocated[idx] = false;
+    if constexpr (!std::is_trivially_copyable_v<T>)
+        stack.free_node_stack.data[idx] = T{}; // Release resources held by the payload.
+    stack.free_node_stack.next[idx] = NULL_INDEX<Index>;
 
-    // Push: add this node back to the free stack.
-    stack.free_node_stack.next_free[idx] = stack.free_node_stack.free_head;
-    stack.free_node_stack.free_head = idx;
+    // Return the node to the pool.
+    NodePool_free(stack.free_node_stack.slots, idx);
 }
 
 // Push a value onto the stack.
-void Stack_push(Stack &stack, const float &value) {
-    int new_node = -1;
+template <typename T, typename Index>
+void Stack_push(Stack<T, Index> &stack, const T &value) {
+    Index new_node = NULL_INDEX<Index>;
     Stack_allocateNode(stack, value, new_node);
-    if (new_node == -1)
+    if (new_node == NULL_INDEX<Index>)
         return;
 
     // Link the new node into the stack.
@@ -90,15 +141,14 @@ void Stack_push(Stack &stack, const float &value) {
     stack.top = new_node;
 }
 
-// Pop a value from the stack.
-// Returns the popped value.
-float Stack_pop(Stack &stack) {
-    if (stack.top == -1) {
-        std::cerr << "Error: Stack underflow." << std::endl;
-        return 0.0f; // Alternatively, throw an exception.
-    }
-    int node_idx = stack.top;
-    float value = stack.free_node_stack.data[node_idx];
+// Pop a value from the stack without reporting an error.
+// Returns the popped value, or ContainerError::Empty if the stack is empty.
+template <typename T, typename Index>
+std::expected<T, ContainerError> Stack_tryPop(Stack<T, Index> &stack) {
+    if (stack.top == NULL_INDEX<Index>)
+        return std::unexpected(ContainerError::Empty);
+    Index node_idx = stack.top;
+    T value = std::move(stack.free_node_stack.data[node_idx]);
     // Update top to the next element in the stack.
     stack.top = stack.free_node_stack.next[node_idx];
     // Deallocate the node.
@@ -106,30 +156,217 @@ float Stack_pop(Stack &stack) {
     return value;
 }
 
+// Pop a value from the stack.
+// Returns the popped value.
+template <typename T, typename Index>
+T Stack_pop(Stack<T, Index> &stack) {
+    auto value = Stack_tryPop(stack);
+    if (!value) {
+        CONTAINER_ERROR(value.error(), "Stack underflow.");
+        return T{}; // Alternatively, throw an exception.
+    }
+    return std::move(*value);
+}
+
 // Peek at the top value of the stack without popping it.
-float Stack_peek(const Stack &stack) {
-    if (stack.top == -1) {
-        std::cerr << "Error: Stack is empty." << std::endl;
-        return 0.0f;
+template <typename T, typename Index>
+T Stack_peek(const Stack<T, Index> &stack) {
+    if (stack.top == NULL_INDEX<Index>) {
+        CONTAINER_ERROR(ContainerError::Empty, "Stack is empty.");
+        return T{};
     }
     return stack.free_node_stack.data[stack.top];
 }
 
+// Run one slice of an incremental compaction, handling at most budget nodes.
+// Renumbers the live nodes so that the stack reads top to bottom as
+// descending consecutive indices, which later pushes continue, and leaves
+// the free nodes as one contiguous tail. Other operations may run between
+// slices. Start with a default-constructed state; returns true once the
+// pass is complete.
+template <typename T, typename Index>
+bool Stack_compactStep(Stack<T, Index> &stack, NodePoolCompaction<Index> &state, const size_t budget) {
+    auto make_links = [&stack] {
+        return NodePoolLinks<T, Index>{stack.free_node_stack.data.get(), stack.free_node_stack.next.get(), nullptr,
+                                       &stack.top, nullptr, true};
+    };
+    auto grow = [&stack] { return stack.free_node_stack.growable && Stack_growPool(stack); };
+    auto shrink = [&stack](const size_t new_size) { Stack_shrinkPool(stack, new_size); };
+    return NodePool_compactStep(stack.free_node_stack.slots, state, budget, make_links, grow, shrink);
+}
+
+// Compact the stack in a single pass.
+template <typename T, typename Index>
+void Stack_compact(Stack<T, Index> &stack) {
+    NodePoolCompaction<Index> state;
+    Stack_compactStep(stack, state, std::numeric_limits<size_t>::max());
+}
+
+// Fraction of links that do not lead to the adjacent node slot (0: fully sequential).
+template <typename T, typename Index>
+double Stack_fragmentation(const Stack<T, Index> &stack) {
+    return NodePool_fragmentation(stack.free_node_stack.next.get(), stack.top, true);
+}
+
 // Print the contents of the stack (from top to bottom).
-void Stack_print(const Stack &stack) {
-    int current = stack.top;
+template <typename T, typename Index>
+void Stack_print(const Stack<T, Index> &stack) {
+    Index current = stack.top;
     std::cout << "Stack: ";
-    while (current != -1) {
+    while (current != NULL_INDEX<Index>) {
         std::cout << stack.free_node_stack.data[current] << " ";
         current = stack.free_node_stack.next[current];
     }
     std::cout << std::endl;
 }
 
+// Lock-free (Treiber) stack over a fixed free-node pool.
+// top and free_head are tagged words: the low 32 bits hold a node index
+// (or -1) and the high 32 bits an ABA counter that is bumped on every
+// successful update, so a node that is popped and pushed back between a
+// thread's load and its CAS cannot be mistaken for the original top.
+// A node sits either on the stack or on the free list, so a single next
+// array links both. The pool does not grow: moving the node arrays would
+// invalidate indices that other threads may still be reading.
+template <typename T>
+struct ConcurrentStack {
+    alignas(64) std::atomic<uint64_t> top{0};       // Tagged index of the top node.
+    alignas(64) std::atomic<uint64_t> free_head{0}; // Tagged index of the first free node.
+
+    // The free node pool holding node arrays.
+    alignas(64) struct {
+        std::unique_ptr<T[]> data{nullptr};                // Node values
+        std::unique_ptr<std::atomic<int>[]> next{nullptr}; // Next pointers (stack or free list)
+        size_t size{0};                                    // Total number of nodes
+    } free_node_stack;
+};
+
+// Pack a node index and an ABA tag into one word.
+uint64_t ConcurrentStack_pack(const int idx, const uint32_t tag) {
+    return (static_cast<uint64_t>(tag) << 32) | static_cast<uint32_t>(idx);
+}
+
+// Extract the node index from a tagged word.
+int ConcurrentStack_index(const uint64_t word) {
+    return static_cast<int>(static_cast<uint32_t>(word));
+}
+
+// Extract the ABA tag from a tagged word.
+uint32_t ConcurrentStack_tag(const uint64_t word) {
+    return static_cast<uint32_t>(word >> 32);
+}
+
+// Initialize the concurrent stack with N nodes.
+// All nodes are initially free and linked as a free stack.
+// Must not race with any other operation.
+template <typename T>
+void ConcurrentStack_init(ConcurrentStack<T> &stack, const size_t &N) {
+    if (N > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        CONTAINER_ERROR(ContainerError::OutOfRange, "Node pool exceeds the index range.");
+        return;
+    }
+    stack.free_node_stack.size = N;
+    stack.free_node_stack.data = std::make_unique<T[]>(N);
+    stack.free_node_stack.next = std::make_unique<std::atomic<int>[]>(N);
+
+    for (size_t i = 0; i < N; ++i) {
+        stack.free_node_stack.next[i].store((i < N - 1) ? static_cast<int>(i + 1) : -1, std::memory_order_relaxed);
+    }
+    stack.top.store(ConcurrentStack_pack(-1, 0), std::memory_order_relaxed);
+    stack.free_head.store(ConcurrentStack_pack((N > 0) ? 0 : -1, 0), std::memory_order_release);
+}
+
+// Pop a node index off the tagged list rooted at head.
+// Returns -1 if the list is empty.
+template <typename T>
+int ConcurrentStack_popNode(ConcurrentStack<T> &stack, std::atomic<uint64_t> &head) {
+    uint64_t old_head = head.load(std::memory_order_acquire);
+    while (true) {
+        int node_idx = ConcurrentStack_index(old_head);
+        if (node_idx == -1)
+            return -1;
+        // The node may be popped and reused concurrently; the tag makes the CAS fail then.
+        int next = stack.free_node_stack.next[node_idx].load(std::memory_order_relaxed);
+        uint64_t new_head = ConcurrentStack_pack(next, ConcurrentStack_tag(old_head) + 1);
+        if (head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+            return node_idx;
+    }
+}
+
+// Push a node index onto the tagged list rooted at head.
+template <typename T>
+void ConcurrentStack_pushNode(ConcurrentStack<T> &stack, std::atomic<uint64_t> &head, const int node_idx) {
+    uint64_t old_head = head.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+        stack.free_node_stack.next[node_idx].store(ConcurrentStack_index(old_head), std::memory_order_relaxed);
+        new_head = ConcurrentStack_pack(node_idx, ConcurrentStack_tag(old_head) + 1);
+    } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Push a value onto the stack. Safe to call from any thread.
+template <typename T>
+void ConcurrentStack_push(ConcurrentStack<T> &stack, const T &value) {
+    int new_node = ConcurrentStack_popNode(stack, stack.free_head);
+    if (new_node == -1) {
+        CONTAINER_ERROR(ContainerError::Full, "No free node available.");
+        return;
+    }
+    stack.free_node_stack.data[new_node] = value;
+    ConcurrentStack_pushNode(stack, stack.top, new_node);
+}
+
+// Pop a value from the stack into value. Safe to call from any thread.
+// Returns false if the stack is empty.
+template <typename T>
+bool ConcurrentStack_tryPop(ConcurrentStack<T> &stack, T &value) {
+    int node_idx = ConcurrentStack_popNode(stack, stack.top);
+    if (node_idx == -1)
+        return false;
+    value = stack.free_node_stack.data[node_idx];
+    ConcurrentStack_pushNode(stack, stack.free_head, node_idx);
+    return true;
+}
+
+// Pop a value from the stack. Safe to call from any thread.
+// Returns the popped value.
+template <typename T>
+T ConcurrentStack_pop(ConcurrentStack<T> &stack) {
+    T value{};
+    if (!ConcurrentStack_tryPop(stack, value))
+        CONTAINER_ERROR(ContainerError::Empty, "Stack underflow.");
+    return value;
+}
+
+// Peek at the top value of the stack without popping it.
+// Only meaningful while no other thread is popping.
+template <typename T>
+T ConcurrentStack_peek(const ConcurrentStack<T> &stack) {
+    int node_idx = ConcurrentStack_index(stack.top.load(std::memory_order_acquire));
+    if (node_idx == -1) {
+        CONTAINER_ERROR(ContainerError::Empty, "Stack is empty.");
+        return T{};
+    }
+    return stack.free_node_stack.data[node_idx];
+}
+
+// Print the contents of the stack (from top to bottom).
+// Must not race with any other operation.
+template <typename T>
+void ConcurrentStack_print(const ConcurrentStack<T> &stack) {
+    int current = ConcurrentStack_index(stack.top.load(std::memory_order_acquire));
+    std::cout << "ConcurrentStack: ";
+    while (current != -1) {
+        std::cout << stack.free_node_stack.data[current] << " ";
+        current = stack.free_node_stack.next[current].load(std::memory_order_relaxed);
+    }
+    std::cout << std::endl;
+}
+
 // Demonstration of stack operations.
 int main() {
     constexpr size_t N = 10;
-    Stack stack;
+    Stack<float> stack;
 
     // Initialize the stack with N nodes.
     Stack_init(stack, N);
@@ -148,5 +385,70 @@ int main() {
     // Peek at the top value.
     std::cout << "Peek: " << Stack_peek(stack) << std::endl;
 
+    // Push past the initial capacity; the pool grows on demand.
+    for (int i = 0; i < 2 * static_cast<int>(N); ++i)
+        Stack_push(stack, static_cast<float>(10 + i));
+    std::cout << "Pool size after growth: " << stack.free_node_stack.slots.size << std::endl;
+    Stack_print(stack);  // Expected: 29 28 ... 10 2 1
+
+    // Each push takes the lowest free node, just above the top, so the stack
+    // stays sequential and compaction finds nothing to move.
+    Stack_compact(stack);
+    std::cout << "Fragmentation: " << Stack_fragmentation(stack) << std::endl;  // Expected: 0
+
+    // Payload and index types are template parameters: 16-byte order IDs
+    // linked with 16-bit indices.
+    struct OrderId {
+        std::uint64_t high;
+        std::uint64_t low;
+    };
+    Stack<OrderId, std::uint16_t> orders;
+    Stack_init(orders, 4);
+    Stack_push(orders, OrderId{1, 1001});
+    Stack_push(orders, OrderId{2, 2002});
+    OrderId order = Stack_pop(orders);
+    std::cout << "Popped order: " << order.high << "-" << order.low << std::endl;  // Expected: 2-2002
+
+    // Drain without error reports: tryPop returns ContainerError::Empty instead.
+    int drained = 0;
+    while (Stack_tryPop(orders))
+        ++drained;
+    std::cout << "Drained orders: " << drained << ", empty: "
+              << (Stack_tryPop(orders).error() == ContainerError::Empty) << std::endl;  // Expected: 1, empty: 1
+
+    // The concurrent stack offers the same operations.
+    ConcurrentStack<float> shared;
+    ConcurrentStack_init(shared, N);
+    ConcurrentStack_push(shared, 1.0f);
+    ConcurrentStack_push(shared, 2.0f);
+    ConcurrentStack_push(shared, 3.0f);
+    ConcurrentStack_print(shared);  // Expected: 3 2 1
+    std::cout << "Popped: " << ConcurrentStack_pop(shared) << std::endl;
+    std::cout << "Peek: " << ConcurrentStack_peek(shared) << std::endl;
+
+    // Several threads push and pop concurrently; every pushed value is popped once.
+    constexpr int THREADS = 4;
+    constexpr int OPS = 100000;
+    ConcurrentStack<float> jobs;
+    ConcurrentStack_init(jobs, THREADS * 4);
+    std::atomic<long long> popped_sum{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&jobs, &popped_sum] {
+            long long local_sum = 0;
+            for (int i = 1; i <= OPS; ++i) {
+                ConcurrentStack_push(jobs, static_cast<float>(i % 1000));
+                float value;
+                while (!ConcurrentStack_tryPop(jobs, value))
+                    std::this_thread::yield();
+                local_sum += static_cast<long long>(value);
+            }
+            popped_sum.fetch_add(local_sum, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    std::cout << "Concurrent popped sum: " << popped_sum.load() << std::endl;  // Expected: 199800000
+
     return 0;
 }
@@ -6,9 +6,22 @@
 #include <ranges>
 #include <numeric>
 #include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <string_view>
+#include <thread>
 
-// Unscoped enumeration for gender.
-enum Gender {
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Unscoped enumeration for gender, one byte per row.
+enum Gender : std::uint8_t {
     MALE, 
     FEMALE
 };
@@ -23,6 +36,179 @@ struct Person {
     std::array<Gender, N> gender{}; 
 };
 
+// Allocator returning Alignment-byte-aligned storage, so every column
+// starts on a cache line (and on a SIMD register boundary).
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+    void deallocate(T *p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept { return true; }
+};
+
+// Contiguous, 64-byte-aligned column of values.
+template <typename T>
+using Column = std::vector<T, AlignedAllocator<T>>;
+
+// Distinct strings, each identified by a dense integer code. The strings
+// are stored back to back in one arena, and an open-addressing hash table
+// of codes maps a string to its code without storing it a second time.
+struct StringDictionary {
+    std::string arena;                  // Distinct strings, back to back.
+    Column<std::uint32_t> offsets{0};   // String code spans arena[offsets[code], offsets[code + 1]).
+    Column<std::uint32_t> slots;        // Hash table of code + 1 per slot (0: empty); size is a power of two.
+};
+
+// Number of distinct strings in the dictionary.
+std::size_t dictionary_size(const StringDictionary& dictionary){
+    return dictionary.offsets.size() - 1;
+}
+
+// String with the given code.
+std::string_view dictionary_string(const StringDictionary& dictionary, std::uint32_t code){
+    return std::string_view(dictionary.arena).substr(dictionary.offsets[code],
+                                                     dictionary.offsets[code + 1] - dictionary.offsets[code]);
+}
+
+// Hash table slot holding value's code, or the empty slot where it would go.
+std::size_t dictionary_slot(const StringDictionary& dictionary, std::string_view value){
+    const std::size_t mask = dictionary.slots.size() - 1;
+    std::size_t slot = std::hash<std::string_view>{}(value) & mask;
+    while (dictionary.slots[slot] != 0 && dictionary_string(dictionary, dictionary.slots[slot] - 1) != value)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+// Look up the code of value. Returns false if value is not in the dictionary.
+bool dictionary_find(const StringDictionary& dictionary, std::string_view value, std::uint32_t& code){
+    if (dictionary.slots.empty())
+        return false;
+    const std::uint32_t entry = dictionary.slots[dictionary_slot(dictionary, value)];
+    code = entry - 1;
+    return entry != 0;
+}
+
+// Code of value, adding value to the dictionary if it is new.
+std::uint32_t dictionary_encode(StringDictionary& dictionary, std::string_view value){
+    // Keep the table at most half full, rehashing the codes into twice the slots.
+    if (2 * (dictionary_size(dictionary) + 1) > dictionary.slots.size()) {
+        Column<std::uint32_t> old_slots(std::max<std::size_t>(16, 2 * dictionary.slots.size()), 0);
+        old_slots.swap(dictionary.slots);
+        for (const std::uint32_t entry : old_slots)
+            if (entry != 0)
+                dictionary.slots[dictionary_slot(dictionary, dictionary_string(dictionary, entry - 1))] = entry;
+    }
+    const std::size_t slot = dictionary_slot(dictionary, value);
+    if (dictionary.slots[slot] == 0) {
+        dictionary.arena.append(value);
+        dictionary.offsets.push_back(static_cast<std::uint32_t>(dictionary.arena.size()));
+        dictionary.slots[slot] = static_cast<std::uint32_t>(dictionary_size(dictionary));
+    }
+    return dictionary.slots[slot] - 1;
+}
+
+// Dictionary-encoded string column: one 4-byte code per row.
+struct DictColumn {
+    StringDictionary dictionary;
+    Column<std::uint32_t> codes;
+};
+
+// Append a string to the column.
+void append_string(DictColumn& column, std::string_view value){
+    column.codes.push_back(dictionary_encode(column.dictionary, value));
+}
+
+// String stored in the given row.
+std::string_view string_at(const DictColumn& column, std::size_t row){
+    return dictionary_string(column.dictionary, column.codes[row]);
+}
+
+// Runtime-sized table of people: the same structure of arrays as Person<N>,
+// with one growable column per field. Names are dictionary-encoded.
+// version counts modifications; edit rows through the functions below so
+// that cached query results notice the change.
+struct PersonTable {
+    std::size_t rows = 0;
+    std::uint64_t version = 0;
+    DictColumn first_name;
+    DictColumn middle_name;
+    DictColumn surname;
+    Column<std::int32_t> age;
+    Column<Gender> gender;
+};
+
+// Reserve room for rows people in every column.
+void reserve(PersonTable& people, std::size_t rows){
+    people.first_name.codes.reserve(rows);
+    people.middle_name.codes.reserve(rows);
+    people.surname.codes.reserve(rows);
+    people.age.reserve(rows);
+    people.gender.reserve(rows);
+}
+
+// Append one person to the table.
+void append_person(PersonTable& people, std::string_view first_name, std::string_view middle_name,
+                   std::string_view surname, std::int32_t age, Gender gender){
+    append_string(people.first_name, first_name);
+    append_string(people.middle_name, middle_name);
+    append_string(people.surname, surname);
+    people.age.push_back(age);
+    people.gender.push_back(gender);
+    ++people.rows;
+    ++people.version;
+}
+
+// Overwrite the age of one row.
+void set_age(PersonTable& people, std::size_t row, std::int32_t age){
+    people.age[row] = age;
+    ++people.version;
+}
+
+// Overwrite the gender of one row.
+void set_gender(PersonTable& people, std::size_t row, Gender gender){
+    people.gender[row] = gender;
+    ++people.version;
+}
+
+// Append every person of a fixed-size block to the table.
+template <std::size_t N>
+void append_people(PersonTable& people, const Person<N>& block){
+    reserve(people, people.rows + N);
+    for (std::size_t idx = 0; idx < N; ++idx)
+        append_person(people, block.first_name[idx], block.middle_name[idx], block.surname[idx],
+                      block.age[idx], block.gender[idx]);
+}
+
+// Fill the table with rows synthetic people, drawn from the names of block.
+template <std::size_t N>
+void fill_synthetic(PersonTable& people, const Person<N>& block, std::size_t rows, unsigned seed = 1){
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, N - 1);
+    std::uniform_int_distribution<std::int32_t> age(0, 99);
+    reserve(people, people.rows + rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        const std::size_t idx = pick(random);
+        append_person(people, block.first_name[idx], block.middle_name[pick(random)],
+                      block.surname[pick(random)], age(random), block.gender[idx]);
+    }
+}
+
 // Function to fill data for 10 people with simulated records.
 void fill_data(Person<10>& people) {
     people.first_name[0] = "John";
@@ -86,163 +272,544 @@ void fill_data(Person<10>& people) {
     people.gender[9] = FEMALE;
 }
 
-void display_person(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::ranges::to<std::vector>();
-    
-    std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
-                  << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
-                  << "Age : " << people.age[idx] << "\n\n";
-    });
+// Count, sum, minimum and maximum of age over the rows of one gender.
+struct AgeStats {
+    std::size_t count = 0;
+    std::int64_t sum = 0;
+    std::int32_t min = std::numeric_limits<std::int32_t>::max();
+    std::int32_t max = std::numeric_limits<std::int32_t>::min();
+};
+
+// Mean age of the selected rows (0 when none is selected).
+float mean(const AgeStats& stats){
+    return stats.count > 0 ? static_cast<float>(stats.sum) / static_cast<float>(stats.count) : 0.0f;
 }
 
-void display_sorted_person(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::ranges::to<std::vector>();
-    
-    std::ranges::sort(indices, [&people](std::size_t idx, std::size_t jdx){
-        return people.age[idx] < people.age[jdx]; 
-    });
-    
-    std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
-                  << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
-                  << "Age : " << people.age[idx] << "\n\n";
+// Fold rows [begin, end) into stats without branching on the gender.
+void age_stats_scalar(const PersonTable& people, Gender gender, std::size_t begin, std::size_t end, AgeStats& stats){
+    for (std::size_t idx = begin; idx < end; ++idx) {
+        const std::int32_t match = people.gender[idx] == gender;
+        const std::int32_t age = people.age[idx];
+        stats.count += static_cast<std::size_t>(match);
+        stats.sum += age & -match;
+        stats.min = std::min(stats.min, match ? age : std::numeric_limits<std::int32_t>::max());
+        stats.max = std::max(stats.max, match ? age : std::numeric_limits<std::int32_t>::min());
+    }
+}
+
+// Aggregate the age column over the rows of one gender in a single fused
+// pass: the gender comparison becomes a mask, and the sum, count and
+// extremes are updated under that mask, with no index vector in between.
+AgeStats age_stats(const PersonTable& people, Gender gender){
+    AgeStats stats;
+    std::size_t idx = 0;
+#if defined(__AVX2__)
+    // Eight rows per step: widen eight gender bytes to 32-bit lanes and compare.
+    const __m256i wanted = _mm256_set1_epi32(gender);
+    const __m256i lowest = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+    const __m256i highest = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::max());
+    __m256i sum_low = _mm256_setzero_si256();
+    __m256i sum_high = _mm256_setzero_si256();
+    __m256i min = highest;
+    __m256i max = lowest;
+    std::size_t count = 0;
+    for (; idx + 8 <= people.rows; idx += 8) {
+        const __m128i genders = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(people.gender.data() + idx));
+        const __m256i mask = _mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(genders), wanted);
+        const __m256i ages = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(people.age.data() + idx));
+        const __m256i selected = _mm256_and_si256(ages, mask);
+        // Sum in 64-bit lanes, so large tables cannot overflow.
+        sum_low = _mm256_add_epi64(sum_low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(selected)));
+        sum_high = _mm256_add_epi64(sum_high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(selected, 1)));
+        min = _mm256_min_epi32(min, _mm256_blendv_epi8(highest, ages, mask));
+        max = _mm256_max_epi32(max, _mm256_blendv_epi8(lowest, ages, mask));
+        count += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)))));
+    }
+    alignas(32) std::int64_t sums[8];
+    alignas(32) std::int32_t mins[8];
+    alignas(32) std::int32_t maxs[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums), sum_low);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums + 4), sum_high);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(mins), min);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxs), max);
+    stats.count = count;
+    for (int lane = 0; lane < 8; ++lane) {
+        stats.sum += sums[lane];
+        stats.min = std::min(stats.min, mins[lane]);
+        stats.max = std::max(stats.max, maxs[lane]);
+    }
+#endif
+    age_stats_scalar(people, gender, idx, people.rows, stats);
+    return stats;
+}
+
+// Filter result with one bit per row: bit idx % 64 of word idx / 64 is set
+// while row idx is selected. Bits past the last row are always clear.
+struct RowBitmap {
+    std::size_t rows = 0;
+    Column<std::uint64_t> words;
+};
+
+// Selected row numbers in ascending order, 4 bytes per selected row.
+using Selection = Column<std::uint32_t>;
+
+// Empty bitmap covering rows rows.
+RowBitmap make_bitmap(std::size_t rows){
+    RowBitmap bitmap;
+    bitmap.rows = rows;
+    bitmap.words.assign((rows + 63) / 64, 0);
+    return bitmap;
+}
+
+// Rows whose gender equals gender.
+RowBitmap where_gender(const PersonTable& people, Gender gender){
+    RowBitmap bitmap = make_bitmap(people.rows);
+    const Gender* column = people.gender.data();
+    std::size_t idx = 0;
+#if defined(__AVX2__)
+    // One byte per row: two 32-byte compares fill a 64-bit word.
+    const __m256i wanted = _mm256_set1_epi8(static_cast<char>(gender));
+    for (; idx + 64 <= people.rows; idx += 64) {
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(column + idx));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(column + idx + 32));
+        const std::uint32_t low_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, wanted)));
+        const std::uint32_t high_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, wanted)));
+        bitmap.words[idx / 64] = (std::uint64_t{high_bits} << 32) | low_bits;
+    }
+#endif
+    for (; idx < people.rows; ++idx)
+        bitmap.words[idx / 64] |= std::uint64_t{column[idx] == gender} << (idx % 64);
+    return bitmap;
+}
+
+// Rows whose age lies in [low, high).
+RowBitmap where_age(const PersonTable& people, std::int32_t low, std::int32_t high){
+    RowBitmap bitmap = make_bitmap(people.rows);
+    for (std::size_t word = 0; word < bitmap.words.size(); ++word) {
+        const std::size_t begin = word * 64;
+        const std::size_t end = std::min(begin + 64, people.rows);
+        std::uint64_t bits = 0;
+        for (std::size_t idx = begin; idx < end; ++idx)
+            bits |= static_cast<std::uint64_t>((people.age[idx] >= low) & (people.age[idx] < high)) << (idx - begin);
+        bitmap.words[word] = bits;
+    }
+    return bitmap;
+}
+
+// Rows whose column value equals value. The string is looked up once;
+// the scan itself only compares codes.
+RowBitmap where_equal(const DictColumn& column, std::string_view value){
+    RowBitmap bitmap = make_bitmap(column.codes.size());
+    std::uint32_t code;
+    if (!dictionary_find(column.dictionary, value, code))
+        return bitmap;
+    for (std::size_t word = 0; word < bitmap.words.size(); ++word) {
+        const std::size_t begin = word * 64;
+        const std::size_t end = std::min(begin + 64, column.codes.size());
+        std::uint64_t bits = 0;
+        for (std::size_t idx = begin; idx < end; ++idx)
+            bits |= static_cast<std::uint64_t>(column.codes[idx] == code) << (idx - begin);
+        bitmap.words[word] = bits;
+    }
+    return bitmap;
+}
+
+// Rows selected by both bitmaps.
+RowBitmap bitmap_and(const RowBitmap& a, const RowBitmap& b){
+    RowBitmap result = make_bitmap(std::min(a.rows, b.rows));
+    for (std::size_t word = 0; word < result.words.size(); ++word)
+        result.words[word] = a.words[word] & b.words[word];
+    return result;
+}
+
+// Rows selected by either bitmap.
+RowBitmap bitmap_or(const RowBitmap& a, const RowBitmap& b){
+    RowBitmap result = make_bitmap(std::min(a.rows, b.rows));
+    for (std::size_t word = 0; word < result.words.size(); ++word)
+        result.words[word] = a.words[word] | b.words[word];
+    return result;
+}
+
+// Number of selected rows.
+std::size_t bitmap_count(const RowBitmap& bitmap){
+    std::size_t count = 0;
+    for (const std::uint64_t word : bitmap.words)
+        count += static_cast<std::size_t>(std::popcount(word));
+    return count;
+}
+
+// Row numbers of the selected rows, for the stages that reorder or print rows.
+Selection to_selection(const RowBitmap& bitmap){
+    Selection selection;
+    selection.reserve(bitmap_count(bitmap));
+    for (std::size_t word = 0; word < bitmap.words.size(); ++word)
+        for (std::uint64_t bits = bitmap.words[word]; bits != 0; bits &= bits - 1)
+            selection.push_back(static_cast<std::uint32_t>(word * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+    return selection;
+}
+
+// Aggregate the age column over the rows selected by bitmap.
+AgeStats age_stats(const PersonTable& people, const RowBitmap& bitmap){
+    AgeStats stats;
+    for (std::size_t word = 0; word < bitmap.words.size(); ++word) {
+        for (std::uint64_t bits = bitmap.words[word]; bits != 0; bits &= bits - 1) {
+            const std::int32_t age = people.age[word * 64 + static_cast<std::size_t>(std::countr_zero(bits))];
+            ++stats.count;
+            stats.sum += age;
+            stats.min = std::min(stats.min, age);
+            stats.max = std::max(stats.max, age);
+        }
+    }
+    return stats;
+}
+
+// Aggregate the age column per distinct value of a string column: entry
+// code of the result holds the rows whose value has that code.
+std::vector<AgeStats> age_stats_by(const PersonTable& people, const DictColumn& column){
+    std::vector<AgeStats> groups(dictionary_size(column.dictionary));
+    for (std::size_t idx = 0; idx < people.rows; ++idx) {
+        AgeStats& group = groups[column.codes[idx]];
+        const std::int32_t age = people.age[idx];
+        ++group.count;
+        group.sum += age;
+        group.min = std::min(group.min, age);
+        group.max = std::max(group.max, age);
+    }
+    return groups;
+}
+
+// Every row of the table, in row order.
+Selection all_rows(const PersonTable& people){
+    Selection selection(people.rows);
+    std::iota(selection.begin(), selection.end(), std::uint32_t{0});
+    return selection;
+}
+
+// Columns that argsort can order rows by.
+enum SortColumn : std::uint8_t {
+    BY_AGE,
+    BY_GENDER,
+    BY_FIRST_NAME,
+    BY_MIDDLE_NAME,
+    BY_SURNAME
+};
+
+// One key of a multi-column sort.
+struct SortKey {
+    SortColumn column;
+    bool descending = false;
+};
+
+// Worker threads to use for n items: at most threads, and one per 64K items.
+unsigned sort_threads(std::size_t n, unsigned threads){
+    return static_cast<unsigned>(std::clamp<std::size_t>(n / 65536, 1, std::max(threads, 1u)));
+}
+
+// Stably reorder selection by keys (keys[i] belongs to selection[i]) with an
+// LSD radix sort on 8-bit digits. Only the digits below the largest key's
+// top bit are sorted, so keys under 256 take a single counting-sort pass.
+// Each pass splits the items across threads: every thread counts the
+// digits of its block, and the blocks are then scattered in block order,
+// which keeps the pass stable.
+void radix_argsort(Selection& selection, Column<std::uint32_t>& keys, unsigned threads){
+    const std::size_t n = selection.size();
+    const std::uint32_t largest = n > 0 ? *std::ranges::max_element(keys) : 0;
+    const int passes = (std::bit_width(largest) + 7) / 8;
+    const unsigned workers = sort_threads(n, threads);
+    const std::size_t block = (n + workers - 1) / workers;
+    Selection next_selection(n);
+    Column<std::uint32_t> next_keys(n);
+    std::vector<std::array<std::size_t, 256>> offsets(workers);
+    // Run work(w) for every block w, block 0 on the calling thread.
+    auto for_each_block = [workers](auto&& work){
+        std::vector<std::thread> pool;
+        for (unsigned w = 1; w < workers; ++w)
+            pool.emplace_back(work, w);
+        work(0u);
+        for (std::thread& thread : pool)
+            thread.join();
+    };
+
+    for (int pass = 0; pass < passes; ++pass) {
+        const int shift = 8 * pass;
+        // Count the digits of each block.
+        for_each_block([&](unsigned w){
+            offsets[w].fill(0);
+            for (std::size_t i = w * block; i < std::min(n, (w + 1) * block); ++i)
+                ++offsets[w][(keys[i] >> shift) & 0xFF];
+        });
+        // Turn the counts into start positions: digit-major, then block order.
+        std::size_t position = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+            for (unsigned w = 0; w < workers; ++w) {
+                const std::size_t count = offsets[w][digit];
+                offsets[w][digit] = position;
+                position += count;
+            }
+        }
+        // Scatter each block to its positions.
+        for_each_block([&](unsigned w){
+            for (std::size_t i = w * block; i < std::min(n, (w + 1) * block); ++i) {
+                const std::size_t target = offsets[w][(keys[i] >> shift) & 0xFF]++;
+                next_selection[target] = selection[i];
+                next_keys[target] = keys[i];
+            }
+        });
+        selection.swap(next_selection);
+        keys.swap(next_keys);
+    }
+}
+
+// Rank of every code of a string column in sorted string order.
+Column<std::uint32_t> string_ranks(const DictColumn& column){
+    const std::size_t size = dictionary_size(column.dictionary);
+    Column<std::uint32_t> order(size);
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+    std::ranges::sort(order, [&column](std::uint32_t a, std::uint32_t b){
+        return dictionary_string(column.dictionary, a) < dictionary_string(column.dictionary, b);
     });
+    Column<std::uint32_t> ranks(size);
+    for (std::uint32_t rank = 0; rank < size; ++rank)
+        ranks[order[rank]] = rank;
+    return ranks;
 }
 
+// Stably order the selected rows by several columns, the first key most
+// significant. Each key becomes an unsigned integer (names by the rank of
+// their code), and the keys are applied from last to first, each with a
+// stable radix pass.
+void argsort(const PersonTable& people, Selection& selection, const std::vector<SortKey>& sort_keys,
+             unsigned threads = std::thread::hardware_concurrency()){
+    Column<std::uint32_t> keys(selection.size());
+    for (auto key = sort_keys.rbegin(); key != sort_keys.rend(); ++key) {
+        const DictColumn* names = key->column == BY_FIRST_NAME  ? &people.first_name
+                                : key->column == BY_MIDDLE_NAME ? &people.middle_name
+                                : key->column == BY_SURNAME     ? &people.surname
+                                                                : nullptr;
+        const Column<std::uint32_t> ranks = names ? string_ranks(*names) : Column<std::uint32_t>{};
+        std::uint32_t low = 0;
+        if (key->column == BY_AGE && !selection.empty()) {
+            // Offset ages by the smallest one, so small ranges need few digits.
+            low = std::numeric_limits<std::uint32_t>::max();
+            for (const std::uint32_t row : selection)
+                low = std::min(low, static_cast<std::uint32_t>(people.age[row]) ^ 0x80000000u);
+        }
+        std::uint32_t high = 0;
+        for (std::size_t i = 0; i < selection.size(); ++i) {
+            const std::uint32_t row = selection[i];
+            keys[i] = key->column == BY_AGE    ? (static_cast<std::uint32_t>(people.age[row]) ^ 0x80000000u) - low
+                    : key->column == BY_GENDER ? static_cast<std::uint32_t>(people.gender[row])
+                                               : ranks[names->codes[row]];
+            high = std::max(high, keys[i]);
+        }
+        if (key->descending)
+            for (std::uint32_t& value : keys)
+                value = high - value;
+        radix_argsort(selection, keys, threads);
+    }
+}
 
-void display_male(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == MALE;
-                   }) |
-                   std::ranges::to<std::vector>();
+// Stably order the selected rows by any comparator on row numbers: each
+// thread sorts one block, then neighbouring blocks are merged pairwise,
+// each pair on its own thread, until one block is left.
+template <typename Compare>
+void parallel_stable_sort(Selection& selection, Compare compare,
+                          unsigned threads = std::thread::hardware_concurrency()){
+    const std::size_t n = selection.size();
+    const unsigned workers = sort_threads(n, threads);
+    std::vector<std::size_t> bounds;
+    for (unsigned w = 0; w <= workers; ++w)
+        bounds.push_back(n * w / workers);
 
-    std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < workers; ++w)
+        pool.emplace_back([&, w]{ std::stable_sort(selection.begin() + bounds[w], selection.begin() + bounds[w + 1], compare); });
+    for (std::thread& thread : pool)
+        thread.join();
+
+    Selection merged(n);
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> next_bounds;
+        pool.clear();
+        for (std::size_t b = 0; b + 1 < bounds.size(); b += 2) {
+            const std::size_t first = bounds[b];
+            const std::size_t middle = bounds[b + 1];
+            const std::size_t last = (b + 2 < bounds.size()) ? bounds[b + 2] : middle;
+            next_bounds.push_back(first);
+            pool.emplace_back([&, first, middle, last]{
+                std::merge(selection.begin() + first, selection.begin() + middle, selection.begin() + middle,
+                           selection.begin() + last, merged.begin() + first, compare);
+            });
+        }
+        next_bounds.push_back(n);
+        for (std::thread& thread : pool)
+            thread.join();
+        selection.swap(merged);
+        bounds = std::move(next_bounds);
+    }
+}
+
+// Order the selected rows by age; rows of equal age keep their order.
+void sort_by_age(const PersonTable& people, Selection& selection){
+    argsort(people, selection, {{BY_AGE}});
+}
+
+// Print the selected rows in selection order.
+void display_rows(const PersonTable& people, const Selection& selection){
+    std::ranges::for_each(selection, [&people](std::uint32_t idx) {
+        std::cout << "Name : " << string_at(people.first_name, idx) << " " 
+                               << string_at(people.middle_name, idx) << " " 
+                               << string_at(people.surname, idx) << '\n'
                   << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
                   << "Age : " << people.age[idx] << "\n\n";
-    });    
+    });
 }
 
-void display_sorted_male(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == MALE;
-                   }) |
+// Predicate bitmaps reused across queries. A bitmap is rebuilt when it was
+// built from another table or the table's version has changed since.
+struct QueryCache {
+    std::array<RowBitmap, 2> gender;                   // gender == MALE and gender == FEMALE, indexed by Gender.
+    std::array<const PersonTable*, 2> gender_source{}; // Table the gender bitmap was built from (null: not built).
+    std::array<std::uint64_t, 2> gender_version{};     // Version of that table when it was built.
+};
+
+// Rows whose gender equals gender, from the cache when it is up to date.
+const RowBitmap& where_gender(const PersonTable& people, QueryCache& cache, Gender gender){
+    if (cache.gender_source[gender] != &people || cache.gender_version[gender] != people.version) {
+        cache.gender[gender] = where_gender(people, gender);
+        cache.gender_source[gender] = &people;
+        cache.gender_version[gender] = people.version;
+    }
+    return cache.gender[gender];
+}
+
+void display_person(const PersonTable & people){
+    auto indices = std::views::iota(std::size_t{0}, people.rows) | 
                    std::ranges::to<std::vector>();
     
-    std::ranges::sort(indices, [&people](std::size_t idx, std::size_t jdx){
-        return people.age[idx] < people.age[jdx]; 
-    });
-
     std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
+        std::cout << "Name : " << string_at(people.first_name, idx) << " " 
+                               << string_at(people.middle_name, idx) << " " 
+                               << string_at(people.surname, idx) << '\n'
                   << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
                   << "Age : " << people.age[idx] << "\n\n";
-    });    
+    });
 }
 
-void display_female(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == FEMALE;
-                   }) |
-                   std::ranges::to<std::vector>();
+void display_sorted_person(const PersonTable & people){
+    Selection selection = all_rows(people);
+    sort_by_age(people, selection);
+    display_rows(people, selection);
+}
 
-    std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
-                  << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
-                  << "Age : " << people.age[idx] << "\n\n";
-    });    
+
+void display_male(const PersonTable & people, QueryCache & cache){
+    Selection selection = to_selection(where_gender(people, cache, MALE));
+    display_rows(people, selection);
 }
 
-void display_sorted_female(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == FEMALE;
-                   }) |
-                   std::ranges::to<std::vector>();
-                   
-    std::ranges::sort(indices, [&people](std::size_t idx, std::size_t jdx){
-        return people.age[idx] < people.age[jdx]; 
-    });
+void display_sorted_male(const PersonTable & people, QueryCache & cache){
+    Selection selection = to_selection(where_gender(people, cache, MALE));
+    sort_by_age(people, selection);
+    display_rows(people, selection);
+}
 
-    std::ranges::for_each(indices, [&people](size_t idx) {
-        std::cout << "Name : " << people.first_name[idx] << " " 
-                               << people.middle_name[idx] << " " 
-                               << people.surname[idx] << '\n'
-                  << "Gender : " << (people.gender[idx] == MALE ? "Male" : "Female") << '\n'
-                  << "Age : " << people.age[idx] << "\n\n";
-    });    
+void display_female(const PersonTable & people, QueryCache & cache){
+    Selection selection = to_selection(where_gender(people, cache, FEMALE));
+    display_rows(people, selection);
 }
 
-void display_avg_age_male(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == MALE;
-                   }) |
-                   std::ranges::to<std::vector>();
-                   
-    int sum_age = 0;
-    std::ranges::for_each(indices, [&people, &sum_age](size_t idx){
-        sum_age += people.age[idx];
-    });
-    
-    float avg_age = static_cast<float>(sum_age) / static_cast<float>(indices.size());
-    
-    std::cout << "Average male age is :" << avg_age << '\n';
+void display_sorted_female(const PersonTable & people, QueryCache & cache){
+    Selection selection = to_selection(where_gender(people, cache, FEMALE));
+    sort_by_age(people, selection);
+    display_rows(people, selection);
 }
 
-void display_avg_age_female(Person<10> & people){
-    auto indices = std::views::iota(0, 10) | 
-                   std::views::filter([&people](size_t idx){
-                       return people.gender[idx] == FEMALE;
-                   }) |
-                   std::ranges::to<std::vector>();
-                   
-    int sum_age = 0;
-    std::ranges::for_each(indices, [&people, &sum_age](size_t idx){
-        sum_age += people.age[idx];
-    });
+void display_avg_age_male(const PersonTable & people){
+    const AgeStats stats = age_stats(people, MALE);
     
-    float avg_age = static_cast<float>(sum_age) / static_cast<float>(indices.size());
+    std::cout << "Average male age is :" << mean(stats) << '\n';
+}
+
+void display_avg_age_female(const PersonTable & people){
+    const AgeStats stats = age_stats(people, FEMALE);
     
-    std::cout << "Average male age is :" << avg_age << '\n';
+    std::cout << "Average female age is :" << mean(stats) << '\n';
 }
 
 
 int main(){
-    Person<10> people;
-    fill_data(people);
+    Person<10> records;
+    fill_data(records);
+    PersonTable people;
+    append_people(people, records);
+    QueryCache cache;
     
     display_person(people);
     std::cout << "\n------------------------------------------------------\n" ;
     display_sorted_person(people);
     std::cout << "\n------------------------------------------------------\n" ;
-    display_male(people);
+    display_male(people, cache);
     std::cout << "\n------------------------------------------------------\n" ;
-    display_female(people);
+    display_female(people, cache);
     std::cout << "\n------------------------------------------------------\n" ;
-    display_sorted_male(people);
+    display_sorted_male(people, cache);
     std::cout << "\n------------------------------------------------------\n" ;
-    display_sorted_female(people);
+    display_sorted_female(people, cache);
     std::cout << "\n------------------------------------------------------\n" ;
     display_avg_age_male(people);
     std::cout << "\n------------------------------------------------------\n" ;
     display_avg_age_female(people);
+    std::cout << "\n------------------------------------------------------\n" ;
+    
+    // The table's row count is only known at runtime.
+    PersonTable batch;
+    fill_synthetic(batch, records, 100000);
+    std::cout << "Synthetic rows : " << batch.rows << '\n';
+    display_avg_age_male(batch);
+    display_avg_age_female(batch);
+    const AgeStats male_stats = age_stats(batch, MALE);
+    std::cout << "Males : " << male_stats.count << ", ages " << male_stats.min << " to " << male_stats.max << '\n';
+    
+    // Compose cached predicate bitmaps: people in their thirties, and men or people under 20.
+    QueryCache batch_cache;
+    const RowBitmap thirties = where_age(batch, 30, 40);
+    const AgeStats male_thirties = age_stats(batch, bitmap_and(where_gender(batch, batch_cache, MALE), thirties));
+    std::cout << "Males in their thirties : " << male_thirties.count << ", average age " << mean(male_thirties) << '\n';
+    const RowBitmap male_or_young = bitmap_or(where_gender(batch, batch_cache, MALE), where_age(batch, 0, 20));
+    std::cout << "Males or under 20 : " << bitmap_count(male_or_young) << '\n';
+    
+    // In-place edits bump the table's version, so the cached bitmap is rebuilt.
+    const std::size_t males = bitmap_count(where_gender(batch, batch_cache, MALE));
+    set_gender(batch, 0, batch.gender[0] == MALE ? FEMALE : MALE);
+    std::cout << "Males after flipping row 0 : " << bitmap_count(where_gender(batch, batch_cache, MALE))
+              << " (was " << males << ")\n";
+    
+    // Name filters and group-bys work on dictionary codes.
+    std::cout << "Distinct surnames : " << dictionary_size(batch.surname.dictionary)
+              << ", named Smith : " << bitmap_count(where_equal(batch.surname, "Smith")) << '\n';
+    const std::vector<AgeStats> by_first_name = age_stats_by(batch, batch.first_name);
+    for (std::uint32_t code = 0; code < by_first_name.size(); ++code)
+        std::cout << "Average age of " << dictionary_string(batch.first_name.dictionary, code) << " : "
+                  << mean(by_first_name[code]) << '\n';
+    
+    // Stable multi-column sort: by surname, then oldest first.
+    Selection roster = all_rows(people);
+    argsort(people, roster, {{BY_SURNAME}, {BY_AGE, true}});
+    std::cout << "By surname :";
+    for (const std::uint32_t idx : roster)
+        std::cout << ' ' << string_at(people.surname, idx);
+    std::cout << '\n';
+    
+    // Any other ordering goes through the parallel merge sort.
+    Selection by_name_length = all_rows(people);
+    parallel_stable_sort(by_name_length, [&people](std::uint32_t idx, std::uint32_t jdx){
+        return string_at(people.first_name, idx).size() < string_at(people.first_name, jdx).size();
+    });
+    std::cout << "By first name length :";
+    for (const std::uint32_t idx : by_name_length)
+        std::cout << ' ' << string_at(people.first_name, idx);
+    std::cout << '\n';
     
     return 0;
 }